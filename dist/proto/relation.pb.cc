@@ -266,8 +266,37 @@ struct GroupUserInfoDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GroupUserInfoDefaultTypeInternal _GroupUserInfo_default_instance_;
+PROTOBUF_CONSTEXPR GetGroupMembersRequest::GetGroupMembersRequest(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.group_id_)*/0
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct GetGroupMembersRequestDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GetGroupMembersRequestDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GetGroupMembersRequestDefaultTypeInternal() {}
+  union {
+    GetGroupMembersRequest _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GetGroupMembersRequestDefaultTypeInternal _GetGroupMembersRequest_default_instance_;
+PROTOBUF_CONSTEXPR GetGroupMembersResponse::GetGroupMembersResponse(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.member_ids_)*/{}
+  , /*decltype(_impl_._member_ids_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.error_msg_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.error_code_)*/0
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct GetGroupMembersResponseDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GetGroupMembersResponseDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GetGroupMembersResponseDefaultTypeInternal() {}
+  union {
+    GetGroupMembersResponse _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GetGroupMembersResponseDefaultTypeInternal _GetGroupMembersResponse_default_instance_;
 }  // namespace relationservice
-static ::_pb::Metadata file_level_metadata_relation_2eproto[17];
+static ::_pb::Metadata file_level_metadata_relation_2eproto[19];
 static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_relation_2eproto = nullptr;
 static const ::_pb::ServiceDescriptor* file_level_service_descriptors_relation_2eproto[1];
 
@@ -415,6 +444,22 @@ const uint32_t TableStruct_relation_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   PROTOBUF_FIELD_OFFSET(::relationservice::GroupUserInfo, _impl_.name_),
   PROTOBUF_FIELD_OFFSET(::relationservice::GroupUserInfo, _impl_.state_),
   PROTOBUF_FIELD_OFFSET(::relationservice::GroupUserInfo, _impl_.role_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::relationservice::GetGroupMembersRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::relationservice::GetGroupMembersRequest, _impl_.group_id_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::relationservice::GetGroupMembersResponse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::relationservice::GetGroupMembersResponse, _impl_.error_code_),
+  PROTOBUF_FIELD_OFFSET(::relationservice::GetGroupMembersResponse, _impl_.error_msg_),
+  PROTOBUF_FIELD_OFFSET(::relationservice::GetGroupMembersResponse, _impl_.member_ids_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::relationservice::AddFriendRequest)},
@@ -434,6 +479,8 @@ static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protode
   { 114, -1, -1, sizeof(::relationservice::GetGroupsResponse)},
   { 123, -1, -1, sizeof(::relationservice::GroupInfo)},
   { 133, -1, -1, sizeof(::relationservice::GroupUserInfo)},
+  { 143, -1, -1, sizeof(::relationservice::GetGroupMembersRequest)},
+  { 150, -1, -1, sizeof(::relationservice::GetGroupMembersResponse)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -454,6 +501,8 @@ static const ::_pb::Message* const file_default_instances[] = {
   &::relationservice::_GetGroupsResponse_default_instance_._instance,
   &::relationservice::_GroupInfo_default_instance_._instance,
   &::relationservice::_GroupUserInfo_default_instance_._instance,
+  &::relationservice::_GetGroupMembersRequest_default_instance_._instance,
+  &::relationservice::_GetGroupMembersResponse_default_instance_._instance,
 };
 
 const char descriptor_table_protodef_relation_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
@@ -486,29 +535,35 @@ const char descriptor_table_protodef_relation_2eproto[] PROTOBUF_SECTION_VARIABL
   "(\t\022\014\n\004desc\030\003 \001(\t\022-\n\005users\030\004 \003(\0132\036.relati"
   "onservice.GroupUserInfo\"F\n\rGroupUserInfo"
   "\022\n\n\002id\030\001 \001(\005\022\014\n\004name\030\002 \001(\t\022\r\n\005state\030\003 \001("
-  "\t\022\014\n\004role\030\004 \001(\t2\362\004\n\017RelationService\022R\n\tA"
-  "ddFriend\022!.relationservice.AddFriendRequ"
-  "est\032\".relationservice.AddFriendResponse\022"
-  "[\n\014RemoveFriend\022$.relationservice.Remove"
-  "FriendRequest\032%.relationservice.RemoveFr"
-  "iendResponse\022X\n\013CreateGroup\022#.relationse"
-  "rvice.CreateGroupRequest\032$.relationservi"
-  "ce.CreateGroupResponse\022R\n\tJoinGroup\022!.re"
-  "lationservice.JoinGroupRequest\032\".relatio"
-  "nservice.JoinGroupResponse\022U\n\nLeaveGroup"
-  "\022\".relationservice.LeaveGroupRequest\032#.r"
-  "elationservice.LeaveGroupResponse\022U\n\nGet"
-  "Friends\022\".relationservice.GetFriendsRequ"
-  "est\032#.relationservice.GetFriendsResponse"
-  "\022R\n\tGetGroups\022!.relationservice.GetGroup"
-  "sRequest\032\".relationservice.GetGroupsResp"
-  "onseB\003\200\001\001b\006proto3"
+  "\t\022\014\n\004role\030\004 \001(\t\"*\n\026GetGroupMembersReques"
+  "t\022\020\n\010group_id\030\001 \001(\005\"T\n\027GetGroupMembersRe"
+  "sponse\022\022\n\nerror_code\030\001 \001(\005\022\021\n\terror_msg\030"
+  "\002 \001(\t\022\022\n\nmember_ids\030\003 \003(\0052\330\005\n\017RelationSe"
+  "rvice\022R\n\tAddFriend\022!.relationservice.Add"
+  "FriendRequest\032\".relationservice.AddFrien"
+  "dResponse\022[\n\014RemoveFriend\022$.relationserv"
+  "ice.RemoveFriendRequest\032%.relationservic"
+  "e.RemoveFriendResponse\022X\n\013CreateGroup\022#."
+  "relationservice.CreateGroupRequest\032$.rel"
+  "ationservice.CreateGroupResponse\022R\n\tJoin"
+  "Group\022!.relationservice.JoinGroupRequest"
+  "\032\".relationservice.JoinGroupResponse\022U\n\n"
+  "LeaveGroup\022\".relationservice.LeaveGroupR"
+  "equest\032#.relationservice.LeaveGroupRespo"
+  "nse\022U\n\nGetFriends\022\".relationservice.GetF"
+  "riendsRequest\032#.relationservice.GetFrien"
+  "dsResponse\022R\n\tGetGroups\022!.relationservic"
+  "e.GetGroupsRequest\032\".relationservice.Get"
+  "GroupsResponse\022d\n\017GetGroupMembers\022\'.rela"
+  "tionservice.GetGroupMembersRequest\032(.rel"
+  "ationservice.GetGroupMembersResponseB\003\200\001"
+  "\001b\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_relation_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_relation_2eproto = {
-    false, false, 1817, descriptor_table_protodef_relation_2eproto,
+    false, false, 2049, descriptor_table_protodef_relation_2eproto,
     "relation.proto",
-    &descriptor_table_relation_2eproto_once, nullptr, 0, 17,
+    &descriptor_table_relation_2eproto_once, nullptr, 0, 19,
     schemas, file_default_instances, TableStruct_relation_2eproto::offsets,
     file_level_metadata_relation_2eproto, file_level_enum_descriptors_relation_2eproto,
     file_level_service_descriptors_relation_2eproto,
@@ -4638,6 +4693,456 @@ void GroupUserInfo::InternalSwap(GroupUserInfo* other) {
 
 // ===================================================================
 
+class GetGroupMembersRequest::_Internal {
+ public:
+};
+
+GetGroupMembersRequest::GetGroupMembersRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:relationservice.GetGroupMembersRequest)
+}
+GetGroupMembersRequest::GetGroupMembersRequest(const GetGroupMembersRequest& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  GetGroupMembersRequest* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.group_id_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.group_id_ = from._impl_.group_id_;
+  // @@protoc_insertion_point(copy_constructor:relationservice.GetGroupMembersRequest)
+}
+
+inline void GetGroupMembersRequest::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.group_id_){0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+GetGroupMembersRequest::~GetGroupMembersRequest() {
+  // @@protoc_insertion_point(destructor:relationservice.GetGroupMembersRequest)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void GetGroupMembersRequest::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void GetGroupMembersRequest::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void GetGroupMembersRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:relationservice.GetGroupMembersRequest)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.group_id_ = 0;
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* GetGroupMembersRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // int32 group_id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _impl_.group_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* GetGroupMembersRequest::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:relationservice.GetGroupMembersRequest)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // int32 group_id = 1;
+  if (this->_internal_group_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(1, this->_internal_group_id(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:relationservice.GetGroupMembersRequest)
+  return target;
+}
+
+size_t GetGroupMembersRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:relationservice.GetGroupMembersRequest)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // int32 group_id = 1;
+  if (this->_internal_group_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_group_id());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetGroupMembersRequest::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    GetGroupMembersRequest::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetGroupMembersRequest::GetClassData() const { return &_class_data_; }
+
+
+void GetGroupMembersRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GetGroupMembersRequest*>(&to_msg);
+  auto& from = static_cast<const GetGroupMembersRequest&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:relationservice.GetGroupMembersRequest)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_group_id() != 0) {
+    _this->_internal_set_group_id(from._internal_group_id());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void GetGroupMembersRequest::CopyFrom(const GetGroupMembersRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:relationservice.GetGroupMembersRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool GetGroupMembersRequest::IsInitialized() const {
+  return true;
+}
+
+void GetGroupMembersRequest::InternalSwap(GetGroupMembersRequest* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_.group_id_, other->_impl_.group_id_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata GetGroupMembersRequest::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_relation_2eproto_getter, &descriptor_table_relation_2eproto_once,
+      file_level_metadata_relation_2eproto[17]);
+}
+
+// ===================================================================
+
+class GetGroupMembersResponse::_Internal {
+ public:
+};
+
+GetGroupMembersResponse::GetGroupMembersResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:relationservice.GetGroupMembersResponse)
+}
+GetGroupMembersResponse::GetGroupMembersResponse(const GetGroupMembersResponse& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  GetGroupMembersResponse* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.member_ids_){from._impl_.member_ids_}
+    , /*decltype(_impl_._member_ids_cached_byte_size_)*/{0}
+    , decltype(_impl_.error_msg_){}
+    , decltype(_impl_.error_code_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.error_msg_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_msg_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_error_msg().empty()) {
+    _this->_impl_.error_msg_.Set(from._internal_error_msg(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.error_code_ = from._impl_.error_code_;
+  // @@protoc_insertion_point(copy_constructor:relationservice.GetGroupMembersResponse)
+}
+
+inline void GetGroupMembersResponse::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.member_ids_){arena}
+    , /*decltype(_impl_._member_ids_cached_byte_size_)*/{0}
+    , decltype(_impl_.error_msg_){}
+    , decltype(_impl_.error_code_){0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.error_msg_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_msg_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+GetGroupMembersResponse::~GetGroupMembersResponse() {
+  // @@protoc_insertion_point(destructor:relationservice.GetGroupMembersResponse)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void GetGroupMembersResponse::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.member_ids_.~RepeatedField();
+  _impl_.error_msg_.Destroy();
+}
+
+void GetGroupMembersResponse::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void GetGroupMembersResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:relationservice.GetGroupMembersResponse)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.member_ids_.Clear();
+  _impl_.error_msg_.ClearToEmpty();
+  _impl_.error_code_ = 0;
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* GetGroupMembersResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // int32 error_code = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _impl_.error_code_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // string error_msg = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_error_msg();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "relationservice.GetGroupMembersResponse.error_msg"));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated int32 member_ids = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt32Parser(_internal_mutable_member_ids(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 24) {
+          _internal_add_member_ids(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* GetGroupMembersResponse::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:relationservice.GetGroupMembersResponse)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // int32 error_code = 1;
+  if (this->_internal_error_code() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(1, this->_internal_error_code(), target);
+  }
+
+  // string error_msg = 2;
+  if (!this->_internal_error_msg().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_error_msg().data(), static_cast<int>(this->_internal_error_msg().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "relationservice.GetGroupMembersResponse.error_msg");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_error_msg(), target);
+  }
+
+  // repeated int32 member_ids = 3;
+  {
+    int byte_size = _impl_._member_ids_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteInt32Packed(
+          3, _internal_member_ids(), byte_size, target);
+    }
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:relationservice.GetGroupMembersResponse)
+  return target;
+}
+
+size_t GetGroupMembersResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:relationservice.GetGroupMembersResponse)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated int32 member_ids = 3;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      Int32Size(this->_impl_.member_ids_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._member_ids_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  // string error_msg = 2;
+  if (!this->_internal_error_msg().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_error_msg());
+  }
+
+  // int32 error_code = 1;
+  if (this->_internal_error_code() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_error_code());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetGroupMembersResponse::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    GetGroupMembersResponse::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetGroupMembersResponse::GetClassData() const { return &_class_data_; }
+
+
+void GetGroupMembersResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GetGroupMembersResponse*>(&to_msg);
+  auto& from = static_cast<const GetGroupMembersResponse&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:relationservice.GetGroupMembersResponse)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.member_ids_.MergeFrom(from._impl_.member_ids_);
+  if (!from._internal_error_msg().empty()) {
+    _this->_internal_set_error_msg(from._internal_error_msg());
+  }
+  if (from._internal_error_code() != 0) {
+    _this->_internal_set_error_code(from._internal_error_code());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void GetGroupMembersResponse::CopyFrom(const GetGroupMembersResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:relationservice.GetGroupMembersResponse)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool GetGroupMembersResponse::IsInitialized() const {
+  return true;
+}
+
+void GetGroupMembersResponse::InternalSwap(GetGroupMembersResponse* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.member_ids_.InternalSwap(&other->_impl_.member_ids_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.error_msg_, lhs_arena,
+      &other->_impl_.error_msg_, rhs_arena
+  );
+  swap(_impl_.error_code_, other->_impl_.error_code_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata GetGroupMembersResponse::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_relation_2eproto_getter, &descriptor_table_relation_2eproto_once,
+      file_level_metadata_relation_2eproto[18]);
+}
+
+// ===================================================================
+
 RelationService::~RelationService() {}
 
 const ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor* RelationService::descriptor() {
@@ -4705,6 +5210,14 @@ void RelationService::GetGroups(::PROTOBUF_NAMESPACE_ID::RpcController* controll
   done->Run();
 }
 
+void RelationService::GetGroupMembers(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                         const ::relationservice::GetGroupMembersRequest*,
+                         ::relationservice::GetGroupMembersResponse*,
+                         ::google::protobuf::Closure* done) {
+  controller->SetFailed("Method GetGroupMembers() not implemented.");
+  done->Run();
+}
+
 void RelationService::CallMethod(const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor* method,
                              ::PROTOBUF_NAMESPACE_ID::RpcController* controller,
                              const ::PROTOBUF_NAMESPACE_ID::Message* request,
@@ -4768,6 +5281,14 @@ void RelationService::CallMethod(const ::PROTOBUF_NAMESPACE_ID::MethodDescriptor
                  response),
              done);
       break;
+    case 7:
+      GetGroupMembers(controller,
+             ::PROTOBUF_NAMESPACE_ID::internal::DownCast<const ::relationservice::GetGroupMembersRequest*>(
+                 request),
+             ::PROTOBUF_NAMESPACE_ID::internal::DownCast<::relationservice::GetGroupMembersResponse*>(
+                 response),
+             done);
+      break;
     default:
       GOOGLE_LOG(FATAL) << "Bad method index; this should never happen.";
       break;
@@ -4792,6 +5313,8 @@ const ::PROTOBUF_NAMESPACE_ID::Message& RelationService::GetRequestPrototype(
       return ::relationservice::GetFriendsRequest::default_instance();
     case 6:
       return ::relationservice::GetGroupsRequest::default_instance();
+    case 7:
+      return ::relationservice::GetGroupMembersRequest::default_instance();
     default:
       GOOGLE_LOG(FATAL) << "Bad method index; this should never happen.";
       return *::PROTOBUF_NAMESPACE_ID::MessageFactory::generated_factory()
@@ -4817,6 +5340,8 @@ const ::PROTOBUF_NAMESPACE_ID::Message& RelationService::GetResponsePrototype(
       return ::relationservice::GetFriendsResponse::default_instance();
     case 6:
       return ::relationservice::GetGroupsResponse::default_instance();
+    case 7:
+      return ::relationservice::GetGroupMembersResponse::default_instance();
     default:
       GOOGLE_LOG(FATAL) << "Bad method index; this should never happen.";
       return *::PROTOBUF_NAMESPACE_ID::MessageFactory::generated_factory()
@@ -4884,6 +5409,13 @@ void RelationService_Stub::GetGroups(::PROTOBUF_NAMESPACE_ID::RpcController* con
   channel_->CallMethod(descriptor()->method(6),
                        controller, request, response, done);
 }
+void RelationService_Stub::GetGroupMembers(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                              const ::relationservice::GetGroupMembersRequest* request,
+                              ::relationservice::GetGroupMembersResponse* response,
+                              ::google::protobuf::Closure* done) {
+  channel_->CallMethod(descriptor()->method(7),
+                       controller, request, response, done);
+}
 
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace relationservice
@@ -4956,6 +5488,14 @@ template<> PROTOBUF_NOINLINE ::relationservice::GroupUserInfo*
 Arena::CreateMaybeMessage< ::relationservice::GroupUserInfo >(Arena* arena) {
   return Arena::CreateMessageInternal< ::relationservice::GroupUserInfo >(arena);
 }
+template<> PROTOBUF_NOINLINE ::relationservice::GetGroupMembersRequest*
+Arena::CreateMaybeMessage< ::relationservice::GetGroupMembersRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::relationservice::GetGroupMembersRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::relationservice::GetGroupMembersResponse*
+Arena::CreateMaybeMessage< ::relationservice::GetGroupMembersResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::relationservice::GetGroupMembersResponse >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
@@ -13,7 +13,7 @@
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3021011 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -67,6 +67,12 @@ extern GetFriendsRequestDefaultTypeInternal _GetFriendsRequest_default_instance_
 class GetFriendsResponse;
 struct GetFriendsResponseDefaultTypeInternal;
 extern GetFriendsResponseDefaultTypeInternal _GetFriendsResponse_default_instance_;
+class GetGroupMembersRequest;
+struct GetGroupMembersRequestDefaultTypeInternal;
+extern GetGroupMembersRequestDefaultTypeInternal _GetGroupMembersRequest_default_instance_;
+class GetGroupMembersResponse;
+struct GetGroupMembersResponseDefaultTypeInternal;
+extern GetGroupMembersResponseDefaultTypeInternal _GetGroupMembersResponse_default_instance_;
 class GetGroupsRequest;
 struct GetGroupsRequestDefaultTypeInternal;
 extern GetGroupsRequestDefaultTypeInternal _GetGroupsRequest_default_instance_;
@@ -106,6 +112,8 @@ template<> ::relationservice::CreateGroupResponse* Arena::CreateMaybeMessage<::r
 template<> ::relationservice::FriendInfo* Arena::CreateMaybeMessage<::relationservice::FriendInfo>(Arena*);
 template<> ::relationservice::GetFriendsRequest* Arena::CreateMaybeMessage<::relationservice::GetFriendsRequest>(Arena*);
 template<> ::relationservice::GetFriendsResponse* Arena::CreateMaybeMessage<::relationservice::GetFriendsResponse>(Arena*);
+template<> ::relationservice::GetGroupMembersRequest* Arena::CreateMaybeMessage<::relationservice::GetGroupMembersRequest>(Arena*);
+template<> ::relationservice::GetGroupMembersResponse* Arena::CreateMaybeMessage<::relationservice::GetGroupMembersResponse>(Arena*);
 template<> ::relationservice::GetGroupsRequest* Arena::CreateMaybeMessage<::relationservice::GetGroupsRequest>(Arena*);
 template<> ::relationservice::GetGroupsResponse* Arena::CreateMaybeMessage<::relationservice::GetGroupsResponse>(Arena*);
 template<> ::relationservice::GroupInfo* Arena::CreateMaybeMessage<::relationservice::GroupInfo>(Arena*);
@@ -3006,6 +3014,343 @@ class GroupUserInfo final :
   union { Impl_ _impl_; };
   friend struct ::TableStruct_relation_2eproto;
 };
+// -------------------------------------------------------------------
+
+class GetGroupMembersRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:relationservice.GetGroupMembersRequest) */ {
+ public:
+  inline GetGroupMembersRequest() : GetGroupMembersRequest(nullptr) {}
+  ~GetGroupMembersRequest() override;
+  explicit PROTOBUF_CONSTEXPR GetGroupMembersRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  GetGroupMembersRequest(const GetGroupMembersRequest& from);
+  GetGroupMembersRequest(GetGroupMembersRequest&& from) noexcept
+    : GetGroupMembersRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline GetGroupMembersRequest& operator=(const GetGroupMembersRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline GetGroupMembersRequest& operator=(GetGroupMembersRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const GetGroupMembersRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const GetGroupMembersRequest* internal_default_instance() {
+    return reinterpret_cast<const GetGroupMembersRequest*>(
+               &_GetGroupMembersRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    17;
+
+  friend void swap(GetGroupMembersRequest& a, GetGroupMembersRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(GetGroupMembersRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(GetGroupMembersRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  GetGroupMembersRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GetGroupMembersRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const GetGroupMembersRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GetGroupMembersRequest& from) {
+    GetGroupMembersRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(GetGroupMembersRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "relationservice.GetGroupMembersRequest";
+  }
+  protected:
+  explicit GetGroupMembersRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kGroupIdFieldNumber = 1,
+  };
+  // int32 group_id = 1;
+  void clear_group_id();
+  int32_t group_id() const;
+  void set_group_id(int32_t value);
+  private:
+  int32_t _internal_group_id() const;
+  void _internal_set_group_id(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:relationservice.GetGroupMembersRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    int32_t group_id_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_relation_2eproto;
+};
+// -------------------------------------------------------------------
+
+class GetGroupMembersResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:relationservice.GetGroupMembersResponse) */ {
+ public:
+  inline GetGroupMembersResponse() : GetGroupMembersResponse(nullptr) {}
+  ~GetGroupMembersResponse() override;
+  explicit PROTOBUF_CONSTEXPR GetGroupMembersResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  GetGroupMembersResponse(const GetGroupMembersResponse& from);
+  GetGroupMembersResponse(GetGroupMembersResponse&& from) noexcept
+    : GetGroupMembersResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline GetGroupMembersResponse& operator=(const GetGroupMembersResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline GetGroupMembersResponse& operator=(GetGroupMembersResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const GetGroupMembersResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const GetGroupMembersResponse* internal_default_instance() {
+    return reinterpret_cast<const GetGroupMembersResponse*>(
+               &_GetGroupMembersResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    18;
+
+  friend void swap(GetGroupMembersResponse& a, GetGroupMembersResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(GetGroupMembersResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(GetGroupMembersResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  GetGroupMembersResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GetGroupMembersResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const GetGroupMembersResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GetGroupMembersResponse& from) {
+    GetGroupMembersResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(GetGroupMembersResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "relationservice.GetGroupMembersResponse";
+  }
+  protected:
+  explicit GetGroupMembersResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMemberIdsFieldNumber = 3,
+    kErrorMsgFieldNumber = 2,
+    kErrorCodeFieldNumber = 1,
+  };
+  // repeated int32 member_ids = 3;
+  int member_ids_size() const;
+  private:
+  int _internal_member_ids_size() const;
+  public:
+  void clear_member_ids();
+  private:
+  int32_t _internal_member_ids(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      _internal_member_ids() const;
+  void _internal_add_member_ids(int32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      _internal_mutable_member_ids();
+  public:
+  int32_t member_ids(int index) const;
+  void set_member_ids(int index, int32_t value);
+  void add_member_ids(int32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      member_ids() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      mutable_member_ids();
+
+  // string error_msg = 2;
+  void clear_error_msg();
+  const std::string& error_msg() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_error_msg(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_error_msg();
+  PROTOBUF_NODISCARD std::string* release_error_msg();
+  void set_allocated_error_msg(std::string* error_msg);
+  private:
+  const std::string& _internal_error_msg() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_error_msg(const std::string& value);
+  std::string* _internal_mutable_error_msg();
+  public:
+
+  // int32 error_code = 1;
+  void clear_error_code();
+  int32_t error_code() const;
+  void set_error_code(int32_t value);
+  private:
+  int32_t _internal_error_code() const;
+  void _internal_set_error_code(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:relationservice.GetGroupMembersResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t > member_ids_;
+    mutable std::atomic<int> _member_ids_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_msg_;
+    int32_t error_code_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_relation_2eproto;
+};
 // ===================================================================
 
 class RelationService_Stub;
@@ -3049,6 +3394,10 @@ class RelationService : public ::PROTOBUF_NAMESPACE_ID::Service {
                        const ::relationservice::GetGroupsRequest* request,
                        ::relationservice::GetGroupsResponse* response,
                        ::google::protobuf::Closure* done);
+  virtual void GetGroupMembers(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::relationservice::GetGroupMembersRequest* request,
+                       ::relationservice::GetGroupMembersResponse* response,
+                       ::google::protobuf::Closure* done);
 
   // implements Service ----------------------------------------------
 
@@ -3106,6 +3455,10 @@ class RelationService_Stub : public RelationService {
                        const ::relationservice::GetGroupsRequest* request,
                        ::relationservice::GetGroupsResponse* response,
                        ::google::protobuf::Closure* done);
+  void GetGroupMembers(::PROTOBUF_NAMESPACE_ID::RpcController* controller,
+                       const ::relationservice::GetGroupMembersRequest* request,
+                       ::relationservice::GetGroupMembersResponse* response,
+                       ::google::protobuf::Closure* done);
  private:
   ::PROTOBUF_NAMESPACE_ID::RpcChannel* channel_;
   bool owns_channel_;
@@ -4548,6 +4901,151 @@ inline void GroupUserInfo::set_allocated_role(std::string* role) {
   // @@protoc_insertion_point(field_set_allocated:relationservice.GroupUserInfo.role)
 }
 
+// -------------------------------------------------------------------
+
+// GetGroupMembersRequest
+
+// int32 group_id = 1;
+inline void GetGroupMembersRequest::clear_group_id() {
+  _impl_.group_id_ = 0;
+}
+inline int32_t GetGroupMembersRequest::_internal_group_id() const {
+  return _impl_.group_id_;
+}
+inline int32_t GetGroupMembersRequest::group_id() const {
+  // @@protoc_insertion_point(field_get:relationservice.GetGroupMembersRequest.group_id)
+  return _internal_group_id();
+}
+inline void GetGroupMembersRequest::_internal_set_group_id(int32_t value) {
+  
+  _impl_.group_id_ = value;
+}
+inline void GetGroupMembersRequest::set_group_id(int32_t value) {
+  _internal_set_group_id(value);
+  // @@protoc_insertion_point(field_set:relationservice.GetGroupMembersRequest.group_id)
+}
+
+// -------------------------------------------------------------------
+
+// GetGroupMembersResponse
+
+// int32 error_code = 1;
+inline void GetGroupMembersResponse::clear_error_code() {
+  _impl_.error_code_ = 0;
+}
+inline int32_t GetGroupMembersResponse::_internal_error_code() const {
+  return _impl_.error_code_;
+}
+inline int32_t GetGroupMembersResponse::error_code() const {
+  // @@protoc_insertion_point(field_get:relationservice.GetGroupMembersResponse.error_code)
+  return _internal_error_code();
+}
+inline void GetGroupMembersResponse::_internal_set_error_code(int32_t value) {
+  
+  _impl_.error_code_ = value;
+}
+inline void GetGroupMembersResponse::set_error_code(int32_t value) {
+  _internal_set_error_code(value);
+  // @@protoc_insertion_point(field_set:relationservice.GetGroupMembersResponse.error_code)
+}
+
+// string error_msg = 2;
+inline void GetGroupMembersResponse::clear_error_msg() {
+  _impl_.error_msg_.ClearToEmpty();
+}
+inline const std::string& GetGroupMembersResponse::error_msg() const {
+  // @@protoc_insertion_point(field_get:relationservice.GetGroupMembersResponse.error_msg)
+  return _internal_error_msg();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void GetGroupMembersResponse::set_error_msg(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.error_msg_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:relationservice.GetGroupMembersResponse.error_msg)
+}
+inline std::string* GetGroupMembersResponse::mutable_error_msg() {
+  std::string* _s = _internal_mutable_error_msg();
+  // @@protoc_insertion_point(field_mutable:relationservice.GetGroupMembersResponse.error_msg)
+  return _s;
+}
+inline const std::string& GetGroupMembersResponse::_internal_error_msg() const {
+  return _impl_.error_msg_.Get();
+}
+inline void GetGroupMembersResponse::_internal_set_error_msg(const std::string& value) {
+  
+  _impl_.error_msg_.Set(value, GetArenaForAllocation());
+}
+inline std::string* GetGroupMembersResponse::_internal_mutable_error_msg() {
+  
+  return _impl_.error_msg_.Mutable(GetArenaForAllocation());
+}
+inline std::string* GetGroupMembersResponse::release_error_msg() {
+  // @@protoc_insertion_point(field_release:relationservice.GetGroupMembersResponse.error_msg)
+  return _impl_.error_msg_.Release();
+}
+inline void GetGroupMembersResponse::set_allocated_error_msg(std::string* error_msg) {
+  if (error_msg != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.error_msg_.SetAllocated(error_msg, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.error_msg_.IsDefault()) {
+    _impl_.error_msg_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:relationservice.GetGroupMembersResponse.error_msg)
+}
+
+// repeated int32 member_ids = 3;
+inline int GetGroupMembersResponse::_internal_member_ids_size() const {
+  return _impl_.member_ids_.size();
+}
+inline int GetGroupMembersResponse::member_ids_size() const {
+  return _internal_member_ids_size();
+}
+inline void GetGroupMembersResponse::clear_member_ids() {
+  _impl_.member_ids_.Clear();
+}
+inline int32_t GetGroupMembersResponse::_internal_member_ids(int index) const {
+  return _impl_.member_ids_.Get(index);
+}
+inline int32_t GetGroupMembersResponse::member_ids(int index) const {
+  // @@protoc_insertion_point(field_get:relationservice.GetGroupMembersResponse.member_ids)
+  return _internal_member_ids(index);
+}
+inline void GetGroupMembersResponse::set_member_ids(int index, int32_t value) {
+  _impl_.member_ids_.Set(index, value);
+  // @@protoc_insertion_point(field_set:relationservice.GetGroupMembersResponse.member_ids)
+}
+inline void GetGroupMembersResponse::_internal_add_member_ids(int32_t value) {
+  _impl_.member_ids_.Add(value);
+}
+inline void GetGroupMembersResponse::add_member_ids(int32_t value) {
+  _internal_add_member_ids(value);
+  // @@protoc_insertion_point(field_add:relationservice.GetGroupMembersResponse.member_ids)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+GetGroupMembersResponse::_internal_member_ids() const {
+  return _impl_.member_ids_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+GetGroupMembersResponse::member_ids() const {
+  // @@protoc_insertion_point(field_list:relationservice.GetGroupMembersResponse.member_ids)
+  return _internal_member_ids();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+GetGroupMembersResponse::_internal_mutable_member_ids() {
+  return &_impl_.member_ids_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+GetGroupMembersResponse::mutable_member_ids() {
+  // @@protoc_insertion_point(field_mutable_list:relationservice.GetGroupMembersResponse.member_ids)
+  return _internal_mutable_member_ids();
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -4583,6 +5081,10 @@ inline void GroupUserInfo::set_allocated_role(std::string* role) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -3,6 +3,7 @@
 #include "gateway.h"
 #include <muduo/base/Logging.h>
 #include "public.hpp"
+#include "loadbalancer.h"
 
 GatewayService::GatewayService(const std::string& ip, uint16_t port)
     : ServiceBase("GatewayService", ip, port)
@@ -15,6 +16,12 @@ GatewayService::GatewayService(const std::string& ip, uint16_t port)
 
 void GatewayService::InitRpcService()
 {
+    // 后端服务可以部署多个节点，按用户id做一致性哈希，同一用户的请求固定落在同一节点，利用节点上的缓存
+    auto consistentHash = []() { return std::make_shared<ConsistentHashLoadBalancer>(); };
+    _userRpcChannel.SetLoadBalancer(consistentHash);
+    _messageRpcChannel.SetLoadBalancer(consistentHash);
+    _relationRpcChannel.SetLoadBalancer(consistentHash);
+
     // 初始化RPC存根
     _userStub = std::make_unique<userservice::UserService::Stub>(&_userRpcChannel);
     _messageStub = std::make_unique<messageservice::MessageService::Stub>(&_messageRpcChannel);
@@ -58,32 +65,18 @@ void GatewayService::OnConnection(const muduo::net::TcpConnectionPtr& conn)
     {
         LOG_INFO << "Client disconnected: " << conn->peerAddress().toIpPort();
         
-        // 处理客户端异常断开
+        // 处理客户端异常断开，登录时已把用户id记录在连接上下文中
         int userId = -1;
+        if (!conn->getContext().empty())
         {
-            std::lock_guard<std::mutex> lock(_connMutex);
-            for (auto it = _userConnMap.begin(); it != _userConnMap.end(); ++it)
-            {
-                if (it->second == conn)
-                {
-                    userId = it->first;
-                    _userConnMap.erase(it);
-                    break;
-                }
-            }
+            userId = boost::any_cast<int>(conn->getContext());
+            _onlineUsers.remove(userId, conn);
         }
         
         if (userId != -1)
         {
             // 调用用户服务更新用户状态
-            userservice::UpdateUserStateRequest request;
-            request.set_id(userId);
-            request.set_state("offline");
-            
-            userservice::UpdateUserStateResponse response;
-            MprpcController controller;
-            
-            _userStub->UpdateUserState(nullptr, &request, &response, nullptr);
+            NotifyUserOffline(userId);
         }
         
         conn->shutdown();
@@ -137,52 +130,85 @@ MsgHandler GatewayService::GetHandler(int msgid)
     }
 }
 
+void GatewayService::NotifyUserOffline(int userId)
+{
+    using Call = AsyncRpcCall<userservice::UpdateUserStateRequest, userservice::UpdateUserStateResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(userId);
+    call->request.set_id(userId);
+    call->request.set_state("offline");
+    
+    _userStub->UpdateUserState(&call->controller, &call->request, &call->response,
+        new MprpcClosure([call, userId]() {
+            if (call->controller.Failed())
+            {
+                LOG_ERROR << "Failed to update user " << userId << " state to offline: " << call->controller.ErrorText();
+            }
+        }));
+}
+
+void GatewayService::SendRpcFailed(const muduo::net::TcpConnectionPtr& conn, int ackMsgId, const MprpcController& controller)
+{
+    json responseJson;
+    responseJson["msgid"] = ackMsgId;
+    responseJson["errno"] = -1;
+    responseJson["errmsg"] = controller.ErrorText();
+    conn->send(responseJson.dump());
+}
+
+// 以下处理器都异步调用后端服务：发出rpc后立即返回，IO线程可以继续处理其他连接，
+// 响应到达后回调在本IO线程中执行
 void GatewayService::HandleLogin(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
 {
     int id = js["id"].get<int>();
     std::string pwd = js["password"];
     
-    LOG_INFO << "User login request, id: " << id;
+    LOG_DEBUG << "User login request, id: " << id;
     
     // 调用用户服务进行登录验证
-    userservice::LoginRequest request;
-    request.set_id(id);
-    request.set_password(pwd);
-    
-    userservice::LoginResponse response;
-    MprpcController controller;
-    
-    _userStub->Login(nullptr, &request, &response, nullptr);
-    
-    if (response.error_code() == 0)
-    {
-        // 登录成功
-        {
-            std::lock_guard<std::mutex> lock(_connMutex);
-            _userConnMap.insert({id, conn});
-        }
-        
-        json responseJson;
-        responseJson["msgid"] = LOGIN_MSG_ACK;
-        responseJson["errno"] = 0;
-        responseJson["id"] = response.id();
-        responseJson["name"] = response.name();
-        responseJson["state"] = response.state();
-        
-        conn->send(responseJson.dump());
-        LOG_INFO << "User " << id << " login successful";
-    }
-    else
-    {
-        // 登录失败
-        json responseJson;
-        responseJson["msgid"] = LOGIN_MSG_ACK;
-        responseJson["errno"] = response.error_code();
-        responseJson["errmsg"] = response.error_msg();
-        
-        conn->send(responseJson.dump());
-        LOG_INFO << "User " << id << " login failed: " << response.error_msg();
-    }
+    using Call = AsyncRpcCall<userservice::LoginRequest, userservice::LoginResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(id);
+    call->request.set_id(id);
+    call->request.set_password(pwd);
+    
+    _userStub->Login(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, id]() {
+            if (call->controller.Failed())
+            {
+                LOG_ERROR << "User " << id << " login rpc failed: " << call->controller.ErrorText();
+                SendRpcFailed(conn, LOGIN_MSG_ACK, call->controller);
+                return;
+            }
+            const userservice::LoginResponse& response = call->response;
+            if (response.error_code() == 0 && conn->connected())
+            {
+                // 登录成功
+                _onlineUsers.add(id, conn);
+                conn->setContext(id);
+                
+                json responseJson;
+                responseJson["msgid"] = LOGIN_MSG_ACK;
+                responseJson["errno"] = 0;
+                responseJson["id"] = response.id();
+                responseJson["name"] = response.name();
+                responseJson["state"] = response.state();
+                
+                conn->send(responseJson.dump());
+                LOG_INFO << "User " << id << " login successful";
+            }
+            else
+            {
+                // 登录失败
+                json responseJson;
+                responseJson["msgid"] = LOGIN_MSG_ACK;
+                responseJson["errno"] = response.error_code();
+                responseJson["errmsg"] = response.error_msg();
+                
+                conn->send(responseJson.dump());
+                LOG_INFO << "User " << id << " login failed: " << response.error_msg();
+            }
+        }));
 }
 
 void GatewayService::HandleRegister(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
@@ -190,34 +216,39 @@ void GatewayService::HandleRegister(const muduo::net::TcpConnectionPtr& conn, js
     std::string name = js["name"];
     std::string pwd = js["password"];
     
-    LOG_INFO << "User register request, name: " << name;
+    LOG_DEBUG << "User register request, name: " << name;
     
     // 调用用户服务进行注册
-    userservice::RegisterRequest request;
-    request.set_name(name);
-    request.set_password(pwd);
-    
-    userservice::RegisterResponse response;
-    MprpcController controller;
-    
-    _userStub->Register(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = REG_MSG_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() == 0)
-    {
-        responseJson["id"] = response.id();
-        LOG_INFO << "User " << name << " registered successfully with id: " << response.id();
-    }
-    else
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_INFO << "User " << name << " registration failed: " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
+    using Call = AsyncRpcCall<userservice::RegisterRequest, userservice::RegisterResponse>;
+    auto call = std::make_shared<Call>();
+    call->request.set_name(name);
+    call->request.set_password(pwd);
+    
+    _userStub->Register(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, name]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, REG_MSG_ACK, call->controller);
+                return;
+            }
+            const userservice::RegisterResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = REG_MSG_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() == 0)
+            {
+                responseJson["id"] = response.id();
+                LOG_INFO << "User " << name << " registered successfully with id: " << response.id();
+            }
+            else
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_INFO << "User " << name << " registration failed: " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
 }
 
 void GatewayService::HandleOneChat(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
@@ -226,31 +257,37 @@ void GatewayService::HandleOneChat(const muduo::net::TcpConnectionPtr& conn, jso
     int toId = js["toid"].get<int>();
     std::string msg = js["msg"];
     
-    LOG_INFO << "One-to-one chat from " << fromId << " to " << toId;
+    LOG_DEBUG << "One-to-one chat from " << fromId << " to " << toId;
     
     // 调用消息服务发送消息
-    messageservice::OneToOneMessageRequest request;
-    request.set_from_id(fromId);
-    request.set_to_id(toId);
-    request.set_message(msg);
-    
-    messageservice::OneToOneMessageResponse response;
-    MprpcController controller;
-    
-    _messageStub->SendOneToOneMessage(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = ONE_CHAT_MSG_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() != 0)
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_ERROR << "Failed to send message from " << fromId << " to " << toId 
-                  << ": " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
+    using Call = AsyncRpcCall<messageservice::OneToOneMessageRequest, messageservice::OneToOneMessageResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(fromId);
+    call->request.set_from_id(fromId);
+    call->request.set_to_id(toId);
+    call->request.set_message(msg);
+    
+    _messageStub->SendOneToOneMessage(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, fromId, toId]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, ONE_CHAT_MSG_ACK, call->controller);
+                return;
+            }
+            const messageservice::OneToOneMessageResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = ONE_CHAT_MSG_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() != 0)
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_ERROR << "Failed to send message from " << fromId << " to " << toId 
+                          << ": " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
 }
 
 void GatewayService::HandleAddFriend(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
@@ -258,30 +295,36 @@ void GatewayService::HandleAddFriend(const muduo::net::TcpConnectionPtr& conn, j
     int userId = js["id"].get<int>();
     int friendId = js["friendid"].get<int>();
     
-    LOG_INFO << "Add friend request from " << userId << " to " << friendId;
+    LOG_DEBUG << "Add friend request from " << userId << " to " << friendId;
     
     // 调用关系服务添加好友
-    relationservice::AddFriendRequest request;
-    request.set_user_id(userId);
-    request.set_friend_id(friendId);
-    
-    relationservice::AddFriendResponse response;
-    MprpcController controller;
-    
-    _relationStub->AddFriend(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = ADD_FRIEND_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() != 0)
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_ERROR << "Failed to add friend from " << userId << " to " << friendId 
-                  << ": " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
+    using Call = AsyncRpcCall<relationservice::AddFriendRequest, relationservice::AddFriendResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(userId);
+    call->request.set_user_id(userId);
+    call->request.set_friend_id(friendId);
+    
+    _relationStub->AddFriend(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, userId, friendId]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, ADD_FRIEND_ACK, call->controller);
+                return;
+            }
+            const relationservice::AddFriendResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = ADD_FRIEND_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() != 0)
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_ERROR << "Failed to add friend from " << userId << " to " << friendId 
+                          << ": " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
 }
 
 void GatewayService::HandleCreateGroup(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
@@ -290,35 +333,41 @@ void GatewayService::HandleCreateGroup(const muduo::net::TcpConnectionPtr& conn,
     std::string groupName = js["groupname"];
     std::string groupDesc = js["groupdesc"];
     
-    LOG_INFO << "Create group request from " << userId << ", group: " << groupName;
+    LOG_DEBUG << "Create group request from " << userId << ", group: " << groupName;
     
     // 调用关系服务创建群组
-    relationservice::CreateGroupRequest request;
-    request.set_user_id(userId);
-    request.set_group_name(groupName);
-    request.set_group_desc(groupDesc);
-    
-    relationservice::CreateGroupResponse response;
-    MprpcController controller;
-    
-    _relationStub->CreateGroup(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = CREATE_GROUP_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() == 0)
-    {
-        responseJson["groupid"] = response.group_id();
-        LOG_INFO << "Group " << groupName << " created successfully with id: " << response.group_id();
-    }
-    else
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_ERROR << "Failed to create group " << groupName << ": " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
+    using Call = AsyncRpcCall<relationservice::CreateGroupRequest, relationservice::CreateGroupResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(userId);
+    call->request.set_user_id(userId);
+    call->request.set_group_name(groupName);
+    call->request.set_group_desc(groupDesc);
+    
+    _relationStub->CreateGroup(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, groupName]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, CREATE_GROUP_ACK, call->controller);
+                return;
+            }
+            const relationservice::CreateGroupResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = CREATE_GROUP_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() == 0)
+            {
+                responseJson["groupid"] = response.group_id();
+                LOG_INFO << "Group " << groupName << " created successfully with id: " << response.group_id();
+            }
+            else
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_ERROR << "Failed to create group " << groupName << ": " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
 }
 
 void GatewayService::HandleAddGroup(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
@@ -326,30 +375,36 @@ void GatewayService::HandleAddGroup(const muduo::net::TcpConnectionPtr& conn, js
     int userId = js["id"].get<int>();
     int groupId = js["groupid"].get<int>();
     
-    LOG_INFO << "Add group request from " << userId << " to group " << groupId;
+    LOG_DEBUG << "Add group request from " << userId << " to group " << groupId;
     
     // 调用关系服务加入群组
-    relationservice::JoinGroupRequest request;
-    request.set_user_id(userId);
-    request.set_group_id(groupId);
-    
-    relationservice::JoinGroupResponse response;
-    MprpcController controller;
-    
-    _relationStub->JoinGroup(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = ADD_GROUP_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() != 0)
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_ERROR << "Failed to join group " << groupId << " for user " << userId 
-                  << ": " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
+    using Call = AsyncRpcCall<relationservice::JoinGroupRequest, relationservice::JoinGroupResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(userId);
+    call->request.set_user_id(userId);
+    call->request.set_group_id(groupId);
+    
+    _relationStub->JoinGroup(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, userId, groupId]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, ADD_GROUP_ACK, call->controller);
+                return;
+            }
+            const relationservice::JoinGroupResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = ADD_GROUP_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() != 0)
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_ERROR << "Failed to join group " << groupId << " for user " << userId 
+                          << ": " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
 }
 
 void GatewayService::HandleGroupChat(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
@@ -358,64 +413,74 @@ void GatewayService::HandleGroupChat(const muduo::net::TcpConnectionPtr& conn, j
     int groupId = js["groupid"].get<int>();
     std::string msg = js["msg"];
     
-    LOG_INFO << "Group chat from " << fromId << " to group " << groupId;
+    LOG_DEBUG << "Group chat from " << fromId << " to group " << groupId;
     
     // 调用消息服务发送群组消息
-    messageservice::GroupMessageRequest request;
-    request.set_from_id(fromId);
-    request.set_group_id(groupId);
-    request.set_message(msg);
-    
-    messageservice::GroupMessageResponse response;
-    MprpcController controller;
-    
-    _messageStub->SendGroupMessage(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = GROUP_CHAT_MSG_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() != 0)
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_ERROR << "Failed to send group message from " << fromId << " to group " << groupId 
-                  << ": " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
+    using Call = AsyncRpcCall<messageservice::GroupMessageRequest, messageservice::GroupMessageResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(fromId);
+    call->request.set_from_id(fromId);
+    call->request.set_group_id(groupId);
+    call->request.set_message(msg);
+    
+    _messageStub->SendGroupMessage(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, fromId, groupId]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, GROUP_CHAT_MSG_ACK, call->controller);
+                return;
+            }
+            const messageservice::GroupMessageResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = GROUP_CHAT_MSG_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() != 0)
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_ERROR << "Failed to send group message from " << fromId << " to group " << groupId 
+                          << ": " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
 }
 
 void GatewayService::HandleLoginOut(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time)
 {
     int userId = js["id"].get<int>();
     
-    LOG_INFO << "User logout request, id: " << userId;
+    LOG_DEBUG << "User logout request, id: " << userId;
     
     // 从连接映射中移除
-    {
-        std::lock_guard<std::mutex> lock(_connMutex);
-        _userConnMap.erase(userId);
-    }
+    _onlineUsers.remove(userId);
+    conn->setContext(boost::any());
     
     // 调用用户服务更新用户状态
-    userservice::UpdateUserStateRequest request;
-    request.set_id(userId);
-    request.set_state("offline");
-    
-    userservice::UpdateUserStateResponse response;
-    MprpcController controller;
-    
-    _userStub->UpdateUserState(nullptr, &request, &response, nullptr);
-    
-    json responseJson;
-    responseJson["msgid"] = LOGINOUT_MSG_ACK;
-    responseJson["errno"] = response.error_code();
-    
-    if (response.error_code() != 0)
-    {
-        responseJson["errmsg"] = response.error_msg();
-        LOG_ERROR << "Failed to update user " << userId << " state to offline: " << response.error_msg();
-    }
-    
-    conn->send(responseJson.dump());
-}
\ No newline at end of file
+    using Call = AsyncRpcCall<userservice::UpdateUserStateRequest, userservice::UpdateUserStateResponse>;
+    auto call = std::make_shared<Call>();
+    call->controller.SetRouteKey(userId);
+    call->request.set_id(userId);
+    call->request.set_state("offline");
+    
+    _userStub->UpdateUserState(&call->controller, &call->request, &call->response,
+        new MprpcClosure([this, conn, call, userId]() {
+            if (call->controller.Failed())
+            {
+                SendRpcFailed(conn, LOGINOUT_MSG_ACK, call->controller);
+                return;
+            }
+            const userservice::UpdateUserStateResponse& response = call->response;
+            json responseJson;
+            responseJson["msgid"] = LOGINOUT_MSG_ACK;
+            responseJson["errno"] = response.error_code();
+            
+            if (response.error_code() != 0)
+            {
+                responseJson["errmsg"] = response.error_msg();
+                LOG_ERROR << "Failed to update user " << userId << " state to offline: " << response.error_msg();
+            }
+            
+            conn->send(responseJson.dump());
+        }));
+}
@@ -10,14 +10,25 @@
 #include <mutex>
 #include "mprpcconsumer.h"
 #include "mprpccontroller.h"
+#include "mprpcclosure.h"
 #include "usr.pb.h"
 #include "messege.pb.h"
 #include "relation.pb.h"
 #include "public.hpp"
+#include "onlineuserregistry.hpp"
 
 using json = nlohmann::json;
 using MsgHandler = std::function<void(const muduo::net::TcpConnectionPtr&, json&, muduo::Timestamp)>;
 
+// 一次异步rpc调用的请求、响应和controller，完成回调执行前保持有效
+template <typename Request, typename Response>
+struct AsyncRpcCall
+{
+    Request request;
+    Response response;
+    MprpcController controller;
+};
+
 // 网关服务实现
 class GatewayService : public ServiceBase
 {
@@ -43,11 +54,8 @@ private:
     // 存储消息ID和对应的业务处理方法
     std::unordered_map<int, MsgHandler> _msgHandlerMap;
     
-    // 存储在线用户的通信连接
-    std::unordered_map<int, muduo::net::TcpConnectionPtr> _userConnMap;
-    
-    // 互斥锁，保证_userConnMap的线程安全
-    std::mutex _connMutex;
+    // 存储在线用户的通信连接，内部分片加锁保证线程安全
+    OnlineUserRegistry _onlineUsers;
     
     // RPC通道
     Mprpcchannel _userRpcChannel;
@@ -61,6 +69,11 @@ private:
     
     // 初始化消息处理器
     void InitMsgHandlers();
+
+    // 通知用户服务把用户置为离线，不等待结果
+    void NotifyUserOffline(int userId);
+    // rpc调用失败(超时、服务不可用等)时回复客户端
+    void SendRpcFailed(const muduo::net::TcpConnectionPtr& conn, int ackMsgId, const MprpcController& controller);
     
     // 消息处理方法
     void HandleLogin(const muduo::net::TcpConnectionPtr& conn, json& js, muduo::Timestamp time);
@@ -47,8 +47,18 @@ int main(int argc, char** argv)
     // 初始化RPC框架
     MprpcApplication::Init(argc + 2, new_argv);
     
-    // 设置日志级别
-    muduo::Logger::setLogLevel(muduo::Logger::DEBUG);
+    // 日志级别与mprpc框架一致，由配置文件loglevel设置，每个请求的日志只在debug级别输出
+    switch (::Logger::GetLogLevel()) {
+        case DEBUG:
+            muduo::Logger::setLogLevel(muduo::Logger::DEBUG);
+            break;
+        case ERROR:
+            muduo::Logger::setLogLevel(muduo::Logger::ERROR);
+            break;
+        default:
+            muduo::Logger::setLogLevel(muduo::Logger::INFO);
+            break;
+    }
     
     // 创建并启动网关服务
     GatewayService gatewayService(ip, port);
@@ -7,6 +7,8 @@
 #include "groupmodel.hpp"
 #include "usermodel.hpp"
 #include "connectionpool.h"
+#include "groupmembercache.hpp"
+#include "redis.hpp"
 #include <muduo/base/Logging.h>
 
 // 关系服务实现
@@ -19,6 +21,7 @@ protected:
     // 实现服务基类的虚函数
     void InitRpcService() override;
     void InitDatabasePool() override;
+    void InitRedis() override;
     
     // 实现RelationService的RPC方法
     void AddFriend(::google::protobuf::RpcController* controller,
@@ -56,7 +59,18 @@ protected:
                    ::relationservice::GetGroupsResponse* response,
                    ::google::protobuf::Closure* done) override;
 
+    void GetGroupMembers(::google::protobuf::RpcController* controller,
+                         const ::relationservice::GetGroupMembersRequest* request,
+                         ::relationservice::GetGroupMembersResponse* response,
+                         ::google::protobuf::Closure* done) override;
+
 private:
+    // 通知其他实例和聊天服务器群成员已变更
+    void NotifyGroupChanged(int groupid);
+
+    // redis命名通道上其他进程的通知
+    void HandleChannelMsg(const std::string& channel, const std::string& msg);
+
     // 好友模型
     FriendModel _friendModel;
     
@@ -66,6 +80,16 @@ private:
     // 用户模型
     UserModel _userModel;
     
+    // 群成员缓存，加群/退群可能落在任意实例上(按用户路由)，其他进程的修改通过redis通知失效
+    GroupMemberCache _groupMembers;
+
+    // 订阅群成员变更通知
+    Redis _redis;
+    bool _redisConnected;
+
+    // 本实例在通知中的标识 ip:port
+    std::string _serverId;
+    
     // 数据库连接池
     ConnectionPool* _connectionPool;
 };
\ No newline at end of file
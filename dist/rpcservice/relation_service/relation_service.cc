@@ -2,10 +2,18 @@
 #include "mprpcprovider.h"
 #include "logger.h"
 #include <iostream>
+#include <sstream>
+
+// 群成员变更的redis通道，与聊天服务器共用，格式: groupid serverid
+static const char* kGroupChannel = "groupmember";
 
 RelationServiceImpl::RelationServiceImpl(const std::string& ip, uint16_t port)
-    : ServiceBase("RelationService", ip, port), _connectionPool(nullptr)
+    : ServiceBase("RelationService", ip, port), _redisConnected(false),
+      _serverId(ip + ":" + std::to_string(port)), _connectionPool(nullptr)
 {
+    // 导出群成员缓存命中率
+    GetMonitor().RegisterGauge("group_cache_hit_rate", [this]() { return _groupMembers.hitRate(); });
+    GetMonitor().RegisterGauge("group_cache_size", [this]() { return static_cast<double>(_groupMembers.size()); });
     std::cout << "RelationServiceImpl created" << std::endl;
 }
 
@@ -22,6 +30,47 @@ void RelationServiceImpl::InitDatabasePool(){
     std::cout << "RelationService database pool initialized" << std::endl;
 }
 
+void RelationServiceImpl::InitRedis(){
+    // 连接失败时只能依赖缓存的过期时间兜底
+    _redisConnected = _redis.connect();
+    if (_redisConnected) {
+        _redis.init_channel_handler([this](std::string channel, std::string msg) {
+            HandleChannelMsg(channel, msg);
+        });
+        _redis.subscribe(std::string(kGroupChannel));
+    } else {
+        LOG_ERROR("RelationService redis unavailable, group member cache relies on ttl");
+    }
+    std::cout << "RelationService redis initialized" << std::endl;
+}
+
+// 通知其他实例和聊天服务器群成员已变更
+void RelationServiceImpl::NotifyGroupChanged(int groupid)
+{
+    if (_redisConnected) {
+        _redis.publish(std::string(kGroupChannel), std::to_string(groupid) + " " + _serverId);
+    }
+}
+
+// redis命名通道上其他进程的通知，本实例的修改已直接更新缓存
+void RelationServiceImpl::HandleChannelMsg(const std::string& channel, const std::string& msg)
+{
+    if (channel != kGroupChannel) {
+        return;
+    }
+    std::istringstream is(msg);
+    int groupid = -1;
+    std::string server;
+    if (!(is >> groupid)) {
+        LOG_ERROR("invalid group member message: %s", msg.c_str());
+        return;
+    }
+    if ((is >> server) && server == _serverId) {
+        return;
+    }
+    _groupMembers.invalidate(groupid);
+}
+
 // 实现RelationService的RPC方法
 void RelationServiceImpl::AddFriend(::google::protobuf::RpcController* controller,
                    const ::relationservice::AddFriendRequest* request,
@@ -72,9 +121,13 @@ void RelationServiceImpl::CreateGroup(::google::protobuf::RpcController* control
     bool result = _groupModel.createGroup(group);
     
     if (result) {
+        // 存储群组创建人信息
+        _groupModel.addGroup(request->user_id(), group.getId(), "creator");
+        _groupMembers.addMember(group.getId(), request->user_id());
+        NotifyGroupChanged(group.getId());
         response->set_error_code(0);
         response->set_error_msg("Success");
-        // TODO: 获取创建的群组ID并设置到响应中
+        response->set_group_id(group.getId());
     } else {
         response->set_error_code(1);
         response->set_error_msg("Failed to create group");
@@ -95,6 +148,8 @@ void RelationServiceImpl::JoinGroup(::google::protobuf::RpcController* controlle
     bool result = _groupModel.addGroup(request->user_id(), request->group_id(), "normal");
     
     if (result) {
+        _groupMembers.addMember(request->group_id(), request->user_id());
+        NotifyGroupChanged(request->group_id());
         response->set_error_code(0);
         response->set_error_msg("Success");
     } else {
@@ -112,10 +167,19 @@ void RelationServiceImpl::LeaveGroup(::google::protobuf::RpcController* controll
                     ::google::protobuf::Closure* done)
 {
     std::cout << "RelationService::LeaveGroup called" << std::endl;
-    // TODO: 实现退出群组的逻辑
     
-    response->set_error_code(0);
-    response->set_error_msg("Success");
+    // 退出群组
+    bool result = _groupModel.quitGroup(request->user_id(), request->group_id());
+    
+    if (result) {
+        _groupMembers.removeMember(request->group_id(), request->user_id());
+        NotifyGroupChanged(request->group_id());
+        response->set_error_code(0);
+        response->set_error_msg("Success");
+    } else {
+        response->set_error_code(1);
+        response->set_error_msg("Failed to leave group");
+    }
     
     // 完成RPC调用
     done->Run();
@@ -178,4 +242,33 @@ void RelationServiceImpl::GetGroups(::google::protobuf::RpcController* controlle
     
     // 完成RPC调用
     done->Run();
-}
\ No newline at end of file
+}
+
+void RelationServiceImpl::GetGroupMembers(::google::protobuf::RpcController* controller,
+                         const ::relationservice::GetGroupMembersRequest* request,
+                         ::relationservice::GetGroupMembersResponse* response,
+                         ::google::protobuf::Closure* done)
+{
+    // 热点群直接从缓存返回，未命中时查库并回填
+    GroupMemberCache::MemberList members = _groupMembers.get(request->group_id(), [this](int groupid, std::vector<int>& ids) {
+        return _groupModel.queryGroupMembers(groupid, ids);
+    });
+    if (!members) {
+        // 数据库不可用且没有缓存，不能当作空群返回
+        response->set_error_code(1);
+        response->set_error_msg("Failed to load group members");
+        done->Run();
+        return;
+    }
+    
+    response->mutable_member_ids()->Reserve(members->size());
+    for (int id : *members) {
+        response->add_member_ids(id);
+    }
+    
+    response->set_error_code(0);
+    response->set_error_msg("Success");
+    
+    // 完成RPC调用
+    done->Run();
+}
@@ -0,0 +1,68 @@
+#ifndef BUSINESSPOOL_H
+#define BUSINESSPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+/*
+    业务线程池，位于muduo IO线程和MsgHandler之间
+    所有工作线程共用一个就绪队列；同一key(同一连接)的任务组成一个strand：
+    同一时刻最多有一个任务在执行或在就绪队列中，其余按提交顺序排在strand中，
+    上一个任务执行完才放行下一个。这样同一连接的消息保持顺序，
+    一个慢任务只阻塞它自己的连接，其他连接的任务由空闲的工作线程执行。
+    做法与MprpcExecutor的orderedPerConnection相同，排队状态由一把锁保护。
+*/
+class BusinessPool
+{
+public:
+    using Task = function<void()>;
+
+    // threadNum为0时不启用线程池，任务直接在调用线程执行
+    BusinessPool(int threadNum, int maxQueueSize = 10000);
+    ~BusinessPool();
+
+    // 启动工作线程
+    void start();
+    // 停止工作线程，已提交的任务全部执行完才返回，可重复调用
+    void stop();
+
+    // 提交key对应的任务，尚未执行的任务达到上限时阻塞调用方；
+    // 未启动或已停止时直接在调用线程执行
+    void run(size_t key, Task task);
+
+    int threadNum() const { return _threadNum; }
+
+private:
+    struct Item
+    {
+        size_t key;
+        Task task;
+    };
+
+    // 工作线程：从就绪队列取任务执行，停止且没有未执行的任务后退出
+    void workerLoop();
+    // 任务执行完毕，放行该key的下一个任务，调用方持有_mutex
+    void finish(size_t key);
+
+    int _threadNum;
+    size_t _maxQueueSize;
+    vector<thread> _workers;
+
+    mutex _mutex;
+    condition_variable _notEmpty; // 就绪队列有任务或停止
+    condition_variable _notFull;  // 未执行的任务数低于上限
+    deque<Item> _ready;                           // 就绪队列
+    unordered_map<size_t, deque<Task>> _strands; // 有任务在执行或就绪的key => 其后排队的任务
+    size_t _pending;                              // 尚未开始执行的任务数
+    bool _running;
+};
+
+#endif
@@ -3,6 +3,9 @@
 
 #include<muduo/net/TcpServer.h>
 #include<muduo/net/EventLoop.h>
+#include "codec.hpp"
+#include "businesspool.hpp"
+#include <atomic>
 
 using namespace muduo;
 using namespace muduo::net;
@@ -11,7 +14,10 @@ public:
     //初始化
     ChatServer(EventLoop* loop, //循环
             const InetAddress& listenAddr, //IP+Port
-            const string& nameArg); //name
+            const string& nameArg, //name
+            MessageCodec::FrameType frameType = MessageCodec::DELIMITER, //分帧方式
+            char delimiter = '\n', //分隔符
+            int workerNum = 4); //业务线程数，0表示在IO线程处理
 
     //启动服务
     void start();
@@ -20,14 +26,19 @@ private:
     //上报链接相关信息
     void onConnection(const TcpConnectionPtr&);
 
-    //上报读写相关信息
-    void onMessage(const TcpConnectionPtr& conn, // 链接
-                    Buffer* buffer, //缓冲区
-                    Timestamp time);// 接受到数据的时间
+    //上报一个完整的消息帧
+    void onFrame(const TcpConnectionPtr& conn, // 链接
+                 string& frame, //消息帧
+                 Timestamp time);// 接受到数据的时间
 
+    // 业务线程池须先于_server声明：析构时_server先关闭IO线程和所有连接，
+    // 连接断开回调仍会向线程池提交清理任务，之后线程池才执行完剩余任务并退出
+    BusinessPool _businessPool;
     TcpServer _server;
     EventLoop* _loop;
+    MessageCodec _codec;
+    std::atomic<size_t> _nextConnId;
 
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -9,9 +9,13 @@
 #include "json.hpp"
 #include "usermodel.hpp"
 #include "offlinemsgmodel.hpp"
+#include "offlinemsgwriter.hpp"
 #include "friendmodel.hpp"
 #include "groupmodel.hpp"
 #include "redis.hpp"
+#include "onlineuserregistry.hpp"
+#include "presencecache.hpp"
+#include "groupmembercache.hpp"
 
 using namespace muduo;
 using namespace muduo::net;
@@ -48,18 +52,38 @@ public:
     MsgHandler getHandler(int msgid);
     //redis处理器
     void handlerRedisSubscirbMsg(int, string);
+    // redis命名通道上其他服务器的通知：用户状态、群成员变更
+    void handlerChannelMsg(string channel, string msg);
+    // 输出缓存与离线消息写入的运行指标
+    void reportStats();
+    // 启动业务：先设置本服务器标识(用于状态通知)，再启动离线消息写入、订阅redis并加载在线用户
+    // 必须在处理任何消息之前调用一次
+    void start(const string &serverId);
 
 private:
     Chatservice();
+    // 更新本机状态缓存并通知其他服务器
+    void updatePresence(int userid, bool online);
+    // 通知其他服务器群成员已变更
+    void notifyGroupChanged(int groupid);
+    // 处理其他服务器的用户状态通知
+    void handlePresenceMsg(const string &msg);
+
     // 存储消息id和其对应的业务处理方法
     unordered_map<int, MsgHandler> _msgHandlerMap;
-    // 存储在线用户的通信连接
-    unordered_map<int, TcpConnectionPtr> _userConnMap;
-    // 定义互斥锁，保证_userConnMap的线程安全
-    mutex _connMutex;
+    // 存储在线用户的通信连接，内部分片加锁保证线程安全
+    OnlineUserRegistry _onlineUsers;
+    // 全部服务器的用户在线状态，路由消息时代替查库
+    PresenceCache _presence;
+    // 群成员缓存，群聊扇出时代替查库
+    GroupMemberCache _groupMembers;
+    // 本服务器标识 ip:port
+    string _serverId;
     // 数据操作类的对象
     UserModel _userModel;
     OfflineMsgModel _offlineMsgModel;
+    // 离线消息异步批量写入
+    OfflineMsgWriter _offlineMsgWriter;
     FriendModel _friendModel;
     GroupModel _groupModel;
 
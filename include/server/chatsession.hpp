@@ -0,0 +1,63 @@
+#ifndef CHATSESSION_H
+#define CHATSESSION_H
+
+#include <muduo/net/TcpConnection.h>
+#include <muduo/net/EventLoop.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "codec.hpp"
+
+using namespace muduo;
+using namespace muduo::net;
+using namespace std;
+
+// 连接上挂载的会话上下文，通过TcpConnection::setContext保存
+struct ChatSession
+{
+    ChatSession(const MessageCodec *codec, size_t connid) : codec(codec), connid(connid), userid(-1) {}
+
+    // 连接所属监听器的编解码器
+    const MessageCodec *codec;
+    // 连接序号，业务线程池按它串行执行同一连接的消息
+    const size_t connid;
+    // 该连接上登录的用户id，未登录为-1
+    atomic_int userid;
+};
+
+using ChatSessionPtr = shared_ptr<ChatSession>;
+
+// 获取连接的会话，未建立会话返回nullptr
+inline ChatSession *getChatSession(const TcpConnectionPtr &conn)
+{
+    const boost::any &context = conn->getContext();
+    if (context.empty())
+    {
+        return nullptr;
+    }
+    return boost::any_cast<const ChatSessionPtr &>(context).get();
+}
+
+// 按连接的分帧方式发送消息，非IO线程调用时投递回连接所在的EventLoop
+inline void sendMessage(const TcpConnectionPtr &conn, const string &msg)
+{
+    EventLoop *loop = conn->getLoop();
+    if (!loop->isInLoopThread())
+    {
+        loop->runInLoop([conn, msg]()
+                        { sendMessage(conn, msg); });
+        return;
+    }
+
+    ChatSession *session = getChatSession(conn);
+    if (session != nullptr && session->codec != nullptr)
+    {
+        session->codec->send(conn, msg);
+    }
+    else
+    {
+        conn->send(msg);
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <muduo/net/TcpConnection.h>
+#include <muduo/net/Buffer.h>
+#include <functional>
+#include <string>
+
+using namespace muduo;
+using namespace muduo::net;
+using namespace std;
+
+/*
+    消息分帧编解码器
+    LENGTH_HEADER: 4字节网络序长度头 + 消息体
+    DELIMITER:     消息体 + 分隔符('\n' 或 '\0')
+*/
+class MessageCodec
+{
+public:
+    enum FrameType
+    {
+        LENGTH_HEADER, // 定长头部
+        DELIMITER,     // 分隔符
+    };
+
+    // 单个完整消息帧的回调
+    using FrameCallback = function<void(const TcpConnectionPtr &, string &, Timestamp)>;
+
+    static const size_t kHeaderLen = sizeof(int32_t);
+    static const size_t kDefaultMaxFrameSize = 64 * 1024;
+
+    MessageCodec(FrameType type,
+                 const FrameCallback &cb,
+                 char delimiter = '\n',
+                 size_t maxFrameSize = kDefaultMaxFrameSize);
+
+    // 一次性解出buffer中所有完整的帧，不完整的帧留在buffer中等待后续数据
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buffer, Timestamp time) const;
+
+    // 按当前分帧方式封装后发送
+    void send(const TcpConnectionPtr &conn, const string &msg) const;
+
+    FrameType type() const { return _type; }
+
+    // 解析命令行中的分帧方式 len | line | nul
+    static bool parseFrameType(const string &name, FrameType &type, char &delimiter);
+
+private:
+    FrameType _type;
+    FrameCallback _frameCallback;
+    char _delimiter;
+    size_t _maxFrameSize;
+};
+
+#endif
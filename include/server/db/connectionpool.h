@@ -9,6 +9,7 @@
 #include <chrono>
 #include <atomic>
 #include <thread>
+#include <unordered_map>
 #include <mysql/mysql.h>
 
 using namespace std;
@@ -29,6 +30,9 @@ public:
     
     // 查询操作 select
     MYSQL_RES* query(const string& sql);
+
+    // 获取服务端预处理语句，同一条sql在该连接上只prepare一次
+    MYSQL_STMT* prepare(const string& sql);
     
     // 刷新连接的起始空闲时间点
     void refreshAliveTime() { _alivetime = steady_clock::now(); }
@@ -42,6 +46,7 @@ public:
 private:
     MYSQL* _conn; // 表示和MySQL Server的一条连接
     steady_clock::time_point _alivetime; // 记录进入空闲状态后的起始存活时间
+    unordered_map<string, MYSQL_STMT*> _stmtCache; // 该连接上已预处理的语句
 };
 
 class ConnectionPool
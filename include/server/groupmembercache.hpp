@@ -0,0 +1,165 @@
+#ifndef GROUPMEMBERCACHE_H
+#define GROUPMEMBERCACHE_H
+
+#include "shardedmap.hpp"
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+/*
+    群成员缓存 groupid => 有序的成员id数组
+    未命中时调用loader从数据库加载，加载失败时不写缓存；加群/退群时直接更新缓存中的数组，
+    其他进程修改后通过invalidate失效。成员数组不可变，读者拿到shared_ptr后在锁外遍历。
+    ttlSec大于0时缓存项过期后重新加载，作为跨进程失效通知丢失时的兜底。
+*/
+class GroupMemberCache
+{
+public:
+    using MemberList = shared_ptr<const vector<int>>;
+    // 加载成功返回true；失败(如数据库不可用)返回false，结果不会被缓存
+    using Loader = function<bool(int groupid, vector<int> &members)>;
+
+    explicit GroupMemberCache(int ttlSec = 300, size_t maxGroups = 100000)
+        : _ttl(chrono::seconds(ttlSec)),
+          _maxPerShard(max<size_t>(1, maxGroups / GroupMap::kShardCount)),
+          _hits(0), _misses(0), _loadFailures(0)
+    {
+    }
+
+    // 获取群成员，未命中或过期时通过loader加载
+    // 加载失败时返回已过期的旧成员列表，没有旧列表时返回nullptr
+    MemberList get(int groupid, const Loader &loader)
+    {
+        uint64_t version;
+        MemberList stale;
+        MemberList cached = _groups.read(groupid, version, [&](const GroupMap::Map &groups)
+                                         {
+                                             auto it = groups.find(groupid);
+                                             if (it == groups.end())
+                                             {
+                                                 return MemberList();
+                                             }
+                                             if (expired(it->second))
+                                             {
+                                                 stale = it->second.members;
+                                                 return MemberList();
+                                             }
+                                             return it->second.members; });
+        if (cached)
+        {
+            ++_hits;
+            return cached;
+        }
+        ++_misses;
+
+        // 锁外查库，期间分片有修改则不写回，避免缓存旧数据
+        vector<int> members;
+        if (!loader(groupid, members))
+        {
+            ++_loadFailures;
+            return stale;
+        }
+        sort(members.begin(), members.end());
+        members.erase(unique(members.begin(), members.end()), members.end());
+        MemberList list = make_shared<const vector<int>>(std::move(members));
+
+        _groups.writeIfUnchanged(groupid, version, [&](GroupMap::Map &groups)
+                                 {
+                                     if (groups.size() >= _maxPerShard && groups.find(groupid) == groups.end())
+                                     {
+                                         groups.erase(groups.begin());
+                                     }
+                                     groups[groupid] = Entry{list, chrono::steady_clock::now()}; });
+        return list;
+    }
+
+    // 成员加入群组
+    void addMember(int groupid, int userid)
+    {
+        update(groupid, [userid](vector<int> &members)
+               {
+                   auto pos = lower_bound(members.begin(), members.end(), userid);
+                   if (pos == members.end() || *pos != userid)
+                   {
+                       members.insert(pos, userid);
+                   } });
+    }
+
+    // 成员退出群组
+    void removeMember(int groupid, int userid)
+    {
+        update(groupid, [userid](vector<int> &members)
+               {
+                   auto pos = lower_bound(members.begin(), members.end(), userid);
+                   if (pos != members.end() && *pos == userid)
+                   {
+                       members.erase(pos);
+                   } });
+    }
+
+    // 删除缓存项，下次访问重新加载
+    void invalidate(int groupid)
+    {
+        _groups.write(groupid, [groupid](GroupMap::Map &groups)
+                      { groups.erase(groupid); });
+    }
+
+    uint64_t hits() const { return _hits; }
+    uint64_t misses() const { return _misses; }
+    uint64_t loadFailures() const { return _loadFailures; }
+
+    // 命中率，尚无访问时为0
+    double hitRate() const
+    {
+        uint64_t hits = _hits;
+        uint64_t total = hits + _misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+
+    // 缓存的群组数
+    size_t size() const { return _groups.size(); }
+
+private:
+    struct Entry
+    {
+        MemberList members;
+        chrono::steady_clock::time_point loadTime;
+    };
+
+    using GroupMap = ShardedMap<int, Entry>;
+
+    bool expired(const Entry &entry) const
+    {
+        return _ttl.count() > 0 && chrono::steady_clock::now() - entry.loadTime > _ttl;
+    }
+
+    // 复制成员数组修改后替换，已被读者持有的旧数组不受影响
+    void update(int groupid, const function<void(vector<int> &)> &modify)
+    {
+        _groups.write(groupid, [&](GroupMap::Map &groups)
+                      {
+                          auto it = groups.find(groupid);
+                          if (it == groups.end())
+                          {
+                              return;
+                          }
+                          vector<int> members(*it->second.members);
+                          modify(members);
+                          it->second.members = make_shared<const vector<int>>(std::move(members)); });
+    }
+
+    const chrono::seconds _ttl;
+    const size_t _maxPerShard;
+    atomic<uint64_t> _hits;
+    atomic<uint64_t> _misses;
+    atomic<uint64_t> _loadFailures;
+    GroupMap _groups;
+};
+
+#endif
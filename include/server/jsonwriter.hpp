@@ -0,0 +1,48 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+    流式json写入器，直接把json文本追加到调用方提供的字符串末尾
+    不构造中间json对象，用于登录响应这类大而扁平的消息；
+    调用方保证start/end成对、对象内先key后value。
+*/
+class JsonWriter
+{
+public:
+    explicit JsonWriter(string &out) : _out(out), _needComma(false) {}
+
+    void startObject() { prefix(); _out += '{'; _needComma = false; }
+    void endObject() { _out += '}'; _needComma = true; }
+    void startArray() { prefix(); _out += '['; _needComma = false; }
+    void endArray() { _out += ']'; _needComma = true; }
+
+    // 对象的键
+    void key(const char *name);
+
+    void value(int v);
+    void value(const string &v);
+    void value(const char *v);
+
+    // 把字符串按json转义后追加到out
+    static void escape(string &out, const char *data, size_t len);
+
+private:
+    // 同一层的元素之间补逗号
+    void prefix()
+    {
+        if (_needComma)
+        {
+            _out += ',';
+        }
+    }
+
+    string &_out;
+    bool _needComma;
+};
+
+#endif
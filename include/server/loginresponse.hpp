@@ -0,0 +1,23 @@
+#ifndef LOGINRESPONSE_H
+#define LOGINRESPONSE_H
+
+#include "user.hpp"
+#include "group.hpp"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+    组装登录成功的响应，直接追加到out
+    nested为true时friends/groups/groupuser是原生json数组；
+    为false时兼容旧客户端，每个元素是一段json字符串，需要客户端再解析一次。
+*/
+void buildLoginResponse(string &out,
+                        const User &user,
+                        const vector<string> &offlinemsg,
+                        const vector<User> &friends,
+                        const vector<Group> &groups,
+                        bool nested);
+
+#endif
@@ -16,8 +16,10 @@ public:
     bool addGroup(int userid, int groupid, string role);
     // 查询用户所在群组信息
     vector<Group> queryGroups(int userid);
-    // 给用户群聊业务给群组其它成员群发消息
-    vector<int> queryGroupUsers(int userid, int groupid);
+    // 查询群组全部成员id，供群成员缓存加载；没有连接或查询失败时返回false
+    bool queryGroupMembers(int groupid, vector<int> &members);
+    // 退出群组
+    bool quitGroup(int userid, int groupid);
 
 
 };
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 using namespace std;
 
 class OfflineMsgModel
@@ -10,6 +11,8 @@ class OfflineMsgModel
 public:
     // 存储用户的离线消息
     bool insert(int userid, string msg);
+    // 批量存储离线消息，一条多行insert语句完成
+    bool insert(const vector<pair<int, string>> &msgs);
     // 删除用户的离线消息
     bool remove(int userid);
     // 查询用户的离线消息
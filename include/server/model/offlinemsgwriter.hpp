@@ -0,0 +1,94 @@
+#ifndef OFFLINEMSGWRITER_H
+#define OFFLINEMSGWRITER_H
+
+#include "offlinemsgmodel.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/*
+    离线消息异步写入器
+    业务线程只把(userid, msg)放入有界队列，后台线程在攒够batchSize条
+    或距上次写入超过flushIntervalMs时，用一条多行insert批量落库。
+    队列满时append阻塞调用方，形成反压；stop时把队列中剩余消息全部写完。
+*/
+class OfflineMsgWriter
+{
+public:
+    // 运行指标
+    struct Stats
+    {
+        size_t queueDepth;       // 当前排队的消息数
+        uint64_t appended;       // 累计入队消息数
+        uint64_t written;        // 累计落库消息数
+        uint64_t failed;         // 写入失败的消息数
+        uint64_t flushes;        // 批量写入次数
+        uint64_t blocked;        // 因队列满而阻塞的append次数
+        uint64_t lastFlushUs;    // 最近一次批量写入耗时(微秒)
+        uint64_t maxFlushUs;     // 批量写入最大耗时(微秒)
+        uint64_t totalFlushUs;   // 批量写入累计耗时(微秒)
+    };
+
+    OfflineMsgWriter(size_t batchSize = 128,
+                     int flushIntervalMs = 20,
+                     size_t maxQueueSize = 10000,
+                     size_t maxBatchBytes = 1024 * 1024);
+    ~OfflineMsgWriter();
+
+    // 启动后台写入线程
+    void start();
+    // 写完队列中剩余的消息后停止，可重复调用
+    void stop();
+
+    // 提交一条离线消息，队列满时阻塞直到有空位；未启动或已停止时同步写入
+    void append(int userid, const string &msg);
+
+    // 登录时调用：取出该用户仍在队列中的消息(按提交顺序)，并等待该用户正在写入的批次落库，
+    // 之后数据库中是该用户更早的离线消息；不等待其他用户的消息
+    vector<string> takePending(int userid);
+
+    Stats stats() const;
+
+private:
+    // 后台线程：按数量或时间阈值取出一批消息写入数据库
+    void writeTask();
+    // 写入一批消息，批量失败时逐条重试
+    void writeBatch(vector<pair<int, string>> &batch);
+
+    const size_t _batchSize;
+    const int _flushIntervalMs;
+    const size_t _maxQueueSize;
+    const size_t _maxBatchBytes;
+
+    OfflineMsgModel _model;
+    thread _thread;
+    bool _running;
+
+    mutable mutex _mutex;
+    condition_variable _notEmpty; // 有新消息或需要立即写入
+    condition_variable _notFull;  // 队列出现空位
+    condition_variable _flushed;  // 一批消息写入完成，takePending等待
+    deque<pair<int, string>> _queue;
+    uint64_t _enqueueSeq; // 累计入队消息数
+    unordered_map<int, size_t> _queuedPerUser;   // userid => 队列中的消息数
+    unordered_map<int, size_t> _inflightPerUser; // userid => 正在写入的消息数
+
+    atomic<uint64_t> _written;
+    atomic<uint64_t> _failed;
+    atomic<uint64_t> _flushes;
+    atomic<uint64_t> _blocked;
+    atomic<uint64_t> _lastFlushUs;
+    atomic<uint64_t> _maxFlushUs;
+    atomic<uint64_t> _totalFlushUs;
+};
+
+#endif
@@ -2,6 +2,8 @@
 #define USERMODEL_H
 
 #include "user.hpp"
+#include <vector>
+using namespace std;
 
 // User表的数据操作类
 class UserModel
@@ -15,6 +17,8 @@ public:
     bool updateState(User user);
     // 重置用户的状态信息
     void resetState();
+    // 查询所有在线用户的id
+    vector<int> queryOnlineUsers();
 
 
 };
@@ -0,0 +1,74 @@
+#ifndef ONLINEUSERREGISTRY_H
+#define ONLINEUSERREGISTRY_H
+
+#include "shardedmap.hpp"
+#include <muduo/net/TcpConnection.h>
+#include <vector>
+
+using namespace muduo;
+using namespace muduo::net;
+using namespace std;
+
+/*
+    在线用户表 userid => TcpConnectionPtr
+    按userid分片，每个分片一把读写锁；查询只加读锁，登录/注销才加写锁。
+    返回的是连接的拷贝，调用方在锁外发送数据。
+*/
+class OnlineUserRegistry
+{
+public:
+    // 记录用户连接，已存在时覆盖
+    void add(int userid, const TcpConnectionPtr &conn)
+    {
+        _conns.write(userid, [&](ConnMap &conns)
+                     { conns[userid] = conn; });
+    }
+
+    // 删除用户连接
+    void remove(int userid)
+    {
+        _conns.write(userid, [userid](ConnMap &conns)
+                     { conns.erase(userid); });
+    }
+
+    // 仅当记录的连接仍是conn时删除，避免误删重新登录后的新连接
+    bool remove(int userid, const TcpConnectionPtr &conn)
+    {
+        return _conns.write(userid, [&](ConnMap &conns)
+                            {
+                                auto it = conns.find(userid);
+                                if (it == conns.end() || it->second != conn)
+                                {
+                                    return false;
+                                }
+                                conns.erase(it);
+                                return true; });
+    }
+
+    // 查询用户连接，不在线返回nullptr
+    TcpConnectionPtr find(int userid) const
+    {
+        return _conns.read(userid, [userid](const ConnMap &conns)
+                           {
+                               auto it = conns.find(userid);
+                               return it == conns.end() ? TcpConnectionPtr() : it->second; });
+    }
+
+    // 批量查询，conns[i]对应ids[i]，不在线为nullptr；每个分片只加一次锁
+    void findBatch(const vector<int> &ids, vector<TcpConnectionPtr> &conns) const
+    {
+        conns.assign(ids.size(), TcpConnectionPtr());
+        _conns.readBatch(ids, [&conns](size_t i, const TcpConnectionPtr &conn)
+                         { conns[i] = conn; });
+    }
+
+    // 在线用户数
+    size_t size() const { return _conns.size(); }
+
+private:
+    using ConnMap = ShardedMap<int, TcpConnectionPtr>::Map;
+
+    ShardedMap<int, TcpConnectionPtr> _conns;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef PRESENCECACHE_H
+#define PRESENCECACHE_H
+
+#include "shardedmap.hpp"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+    用户在线状态缓存 userid => 所在服务器
+    只保存在线用户，查不到即离线。启动时从数据库加载一次，
+    之后由本机登录/注销和redis上其他服务器的状态通知维护，路由时不再查库。
+    按userid分片存放在ShardedMap中。
+*/
+class PresenceCache
+{
+public:
+    // 用户上线，server为所在服务器标识，未知时为空
+    void setOnline(int userid, const string &server)
+    {
+        _users.write(userid, [&](UserMap &users)
+                     { users[userid] = server; });
+    }
+
+    // 用户下线
+    void setOffline(int userid)
+    {
+        _users.write(userid, [userid](UserMap &users)
+                     { users.erase(userid); });
+    }
+
+    // 仅当用户登记在server上(或所在服务器未知)时置为离线，避免覆盖在别处的新登录
+    bool setOffline(int userid, const string &server)
+    {
+        return _users.write(userid, [&](UserMap &users)
+                            {
+                                auto it = users.find(userid);
+                                if (it == users.end() || (!it->second.empty() && it->second != server))
+                                {
+                                    return false;
+                                }
+                                users.erase(it);
+                                return true; });
+    }
+
+    // 查询用户是否在线，在线时通过server返回所在服务器
+    bool isOnline(int userid, string *server = nullptr) const
+    {
+        return _users.read(userid, [&](const UserMap &users)
+                           {
+                               auto it = users.find(userid);
+                               if (it == users.end())
+                               {
+                                   return false;
+                               }
+                               if (server != nullptr)
+                               {
+                                   *server = it->second;
+                               }
+                               return true; });
+    }
+
+    // 批量查询，servers[i]对应ids[i]，online[i]为0表示离线；每个分片只加一次锁
+    void queryBatch(const vector<int> &ids, vector<char> &online, vector<string> &servers) const
+    {
+        online.assign(ids.size(), 0);
+        servers.assign(ids.size(), string());
+        _users.readBatch(ids, [&](size_t i, const string &server)
+                         {
+                             online[i] = 1;
+                             servers[i] = server; });
+    }
+
+    // 在线用户数
+    size_t size() const { return _users.size(); }
+
+private:
+    using UserMap = ShardedMap<int, string>::Map;
+
+    ShardedMap<int, string> _users;
+};
+
+#endif
@@ -4,6 +4,8 @@
 #include <hiredis/hiredis.h>
 #include <thread>
 #include <functional>
+#include <string>
+#include <mutex>
 using namespace std;
 
 class Redis
@@ -16,14 +18,20 @@ public:
     bool connect();
     // 向redis指定的通道channel发布消息
     bool publish(int channel, string message);
+    // 向命名通道发布消息
+    bool publish(const string &channel, const string &message);
     // 向redis指定的通道subscribe订阅消息
     bool subscribe(int channel);
+    // 订阅命名通道，消息通过init_channel_handler的回调上报
+    bool subscribe(const string &channel);
     // 向redis指定的通道unsubscribe取消订阅消息
     bool unsubscribe(int channel);
     // 在独立线程中接收订阅通道中的消息
     void observer_channel_message();
     // 初始化向业务层上报通道消息的回调对象
     void init_notify_handler(function<void(int, string)> fn);
+    // 初始化命名通道消息的回调对象
+    void init_channel_handler(function<void(string, string)> fn);
 
 
 private:
@@ -33,6 +41,11 @@ private:
     redisContext *_subscribe_context;
     // 回调操作，收到订阅的消息，给service层上报
     function<void(int, string)> _notify_message_handler;
+    // 回调操作，收到命名通道的消息，给service层上报
+    function<void(string, string)> _channel_message_handler;
+    // 业务线程并发使用同一个上下文，写命令时加锁
+    mutex _publish_mutex;
+    mutex _subscribe_mutex;
 };
 
 #endif
\ No newline at end of file
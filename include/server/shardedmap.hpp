@@ -0,0 +1,133 @@
+#ifndef SHARDEDMAP_H
+#define SHARDEDMAP_H
+
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+/*
+    分片的并发哈希表 K => V，在线用户表、在线状态缓存、群成员缓存共用
+    按key的哈希分成kShardCount个分片，每个分片一把读写锁并独占缓存行；查询只加读锁，修改才加写锁。
+    通过read/write传入的函数在锁内访问分片的map，函数内不要做耗时操作。
+    每个分片有版本号，write时递增：调用方可在读锁下记录版本号，锁外做耗时操作(如查库)，
+    再用writeIfUnchanged写回，期间分片有修改则放弃，避免写入旧数据。
+*/
+template <typename K, typename V>
+class ShardedMap
+{
+public:
+    using Map = unordered_map<K, V>;
+
+    static const size_t kShardCount = 32;
+
+    // 读锁下访问key所在分片，返回func(map)的结果
+    template <typename Func>
+    auto read(const K &key, Func &&func) const -> decltype(func(declval<const Map &>()))
+    {
+        const Shard &shard = shardOf(key);
+        shared_lock<shared_mutex> lock(shard.mutex);
+        return func(shard.map);
+    }
+
+    // 同上，并在同一把读锁下取出分片版本号
+    template <typename Func>
+    auto read(const K &key, uint64_t &version, Func &&func) const -> decltype(func(declval<const Map &>()))
+    {
+        const Shard &shard = shardOf(key);
+        shared_lock<shared_mutex> lock(shard.mutex);
+        version = shard.version;
+        return func(shard.map);
+    }
+
+    // 写锁下修改key所在分片，分片版本号递增
+    template <typename Func>
+    auto write(const K &key, Func &&func) -> decltype(func(declval<Map &>()))
+    {
+        Shard &shard = shardOf(key);
+        unique_lock<shared_mutex> lock(shard.mutex);
+        ++shard.version;
+        return func(shard.map);
+    }
+
+    // 分片版本号仍为version时在写锁下执行func，返回是否执行
+    template <typename Func>
+    bool writeIfUnchanged(const K &key, uint64_t version, Func &&func)
+    {
+        Shard &shard = shardOf(key);
+        unique_lock<shared_mutex> lock(shard.mutex);
+        if (shard.version != version)
+        {
+            return false;
+        }
+        func(shard.map);
+        return true;
+    }
+
+    // 批量查询：对找到的keys[i]调用func(i, value)；按分片分组，每个分片只加一次读锁
+    template <typename Func>
+    void readBatch(const vector<K> &keys, Func &&func) const
+    {
+        vector<size_t> order(keys.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        sort(order.begin(), order.end(), [&](size_t a, size_t b)
+             { return shardIndex(keys[a]) < shardIndex(keys[b]); });
+
+        size_t i = 0;
+        while (i < order.size())
+        {
+            size_t index = shardIndex(keys[order[i]]);
+            const Shard &shard = _shards[index];
+            shared_lock<shared_mutex> lock(shard.mutex);
+            for (; i < order.size() && shardIndex(keys[order[i]]) == index; ++i)
+            {
+                auto it = shard.map.find(keys[order[i]]);
+                if (it != shard.map.end())
+                {
+                    func(order[i], it->second);
+                }
+            }
+        }
+    }
+
+    // 元素总数，逐个分片加锁统计，只是近似值
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const Shard &shard : _shards)
+        {
+            shared_lock<shared_mutex> lock(shard.mutex);
+            total += shard.map.size();
+        }
+        return total;
+    }
+
+private:
+    // 独占缓存行，避免分片之间伪共享
+    struct alignas(64) Shard
+    {
+        mutable shared_mutex mutex;
+        Map map;
+        uint64_t version = 0; // 每次write递增
+    };
+
+    static size_t shardIndex(const K &key)
+    {
+        return hash<K>()(key) % kShardCount;
+    }
+    Shard &shardOf(const K &key) { return _shards[shardIndex(key)]; }
+    const Shard &shardOf(const K &key) const { return _shards[shardIndex(key)]; }
+
+    Shard _shards[kShardCount];
+};
+
+#endif
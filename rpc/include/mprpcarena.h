@@ -0,0 +1,50 @@
+#pragma once
+
+#include <google/protobuf/arena.h>
+#include <mutex>
+#include <vector>
+
+// 一次rpc调用使用的arena，自带一块初始内存；Reset后初始内存保留复用，超出部分交还系统
+class MprpcCallArena
+{
+public:
+    static const size_t kInitialBlockSize = 4096;
+
+    MprpcCallArena();
+
+    google::protobuf::Arena *Get() { return &_arena; }
+    // 析构arena上的对象并释放超出初始内存的部分
+    void Reset() { _arena.Reset(); }
+
+private:
+    static google::protobuf::ArenaOptions MakeOptions(char *block);
+
+    alignas(16) char _initialBlock[kInitialBlockSize];
+    google::protobuf::Arena _arena;
+};
+
+/*
+    rpc调用arena的回收池
+    request、response和完成回调都分配在同一个arena上，响应发出后整体归还，
+    下一次调用直接在其初始内存上分配，小消息的调用不再经过全局分配器。
+    arena在IO线程取出、在工作线程归还，因此用锁保护的空闲链表而不是按线程缓存。
+*/
+class MprpcArenaPool
+{
+public:
+    explicit MprpcArenaPool(size_t maxIdle = 256) : _maxIdle(maxIdle) {}
+    ~MprpcArenaPool();
+
+    // 取出一个空闲arena，没有时新建
+    MprpcCallArena *Acquire();
+    // 归还arena，其上的对象全部析构；空闲数超过上限时直接释放
+    void Release(MprpcCallArena *arena);
+
+private:
+    MprpcArenaPool(const MprpcArenaPool &) = delete;
+    MprpcArenaPool &operator=(const MprpcArenaPool &) = delete;
+
+    const size_t _maxIdle;
+    std::mutex _mutex;
+    std::vector<MprpcCallArena *> _idle;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <google/protobuf/service.h>
+#include <functional>
+
+// 以std::function作为rpc完成回调的Closure，Run执行一次后自行释放
+// 用于provider回复响应和异步调用方的完成通知
+class MprpcClosure : public google::protobuf::Closure
+{
+public:
+    explicit MprpcClosure(std::function<void()> fn) : _fn(std::move(fn)) {}
+
+    void Run() override
+    {
+        _fn();
+        delete this;
+    }
+
+private:
+    std::function<void()> _fn;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "mprpcheader.pb.h"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include <muduo/net/Buffer.h>
+#include <muduo/net/TcpConnection.h>
+#include <string>
+
+/*
+    rpc帧编解码，请求和响应使用同一格式：
+    | frameLen(4字节) | headerLen(4字节) | header | body |
+    两个长度均为网络字节序，frameLen不含自身；header为mpRpcHeader，body为请求或响应消息
+*/
+class MprpcCodec
+{
+public:
+    static const size_t kLengthSize = 4;
+    // 单帧上限，超过视为协议错误
+    static const size_t kMaxFrameSize = 64 * 1024 * 1024;
+
+    enum DecodeResult
+    {
+        kFrameOk,         // 解出一帧
+        kFrameIncomplete, // 数据未收全
+        kFrameError,      // 协议错误，应关闭连接
+    };
+
+    // 把header和body编码成一帧追加到out尾部，body可为空；header.args_size由此处设置
+    // header和body直接序列化到out中，不产生中间字符串
+    static bool Encode(mprpc::mpRpcHeader &header, const google::protobuf::Message *body, std::string *out);
+
+    // 把编码好的帧交给连接所在的IO线程写socket
+    // 跨线程直接调用conn->send会把数据再复制一份，这里把frame整体移交过去，不产生额外拷贝
+    static void Send(const muduo::net::TcpConnectionPtr &conn, std::string &&frame);
+
+    // 方法id：方法全名(package.Service.Method)的32位FNV-1a哈希，0保留表示未设置
+    // 调用方和服务端各自从描述符计算，无需额外协商
+    static uint32_t MethodId(const std::string &fullName);
+    static uint32_t MethodId(const google::protobuf::MethodDescriptor *method) { return MethodId(method->full_name()); }
+
+    // 从buf可读数据的开头解出一帧，不移动读指针
+    // 成功时body指向buf内的消息体，frameSize为整帧字节数，处理完后由调用方retrieve(frameSize)
+    static DecodeResult Decode(const muduo::net::Buffer *buf, mprpc::mpRpcHeader *header,
+                               const char **body, size_t *bodyLen, size_t *frameSize);
+};
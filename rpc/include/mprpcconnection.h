@@ -0,0 +1,96 @@
+#pragma once
+
+#include <muduo/net/TcpClient.h>
+#include <muduo/net/EventLoop.h>
+#include <muduo/net/EventLoopThread.h>
+#include <muduo/net/Buffer.h>
+#include <muduo/net/TimerId.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// 到一个rpc服务节点的长连接，多个在途请求按request_id复用同一条连接
+class MprpcConnection : public std::enable_shared_from_this<MprpcConnection>
+{
+public:
+    // 响应回调，在IO线程执行；errText为空表示成功，data/len为响应消息体
+    using ResponseCallback = std::function<void(const std::string &errText, const char *data, size_t len)>;
+
+    MprpcConnection(muduo::net::EventLoop *loop, const std::string &ip, uint16_t port);
+
+    // 连接建立前最多缓存的请求帧数，超出时新请求直接失败
+    static const size_t kMaxUnsent = 1024;
+
+    // 发送一帧请求，连接尚未建立时先缓存，建立后按序发出；超时或取消的请求帧不再发出
+    // timeoutSec秒内未收到响应时以超时错误回调；每个请求的回调恰好执行一次(Cancel的除外)
+    void Send(uint64_t requestId, std::string frame, ResponseCallback cb, double timeoutSec);
+    // 调用方不再等待该请求，之后到达的响应直接丢弃；返回请求是否仍在等待
+    bool Cancel(uint64_t requestId);
+    // 连接是否已建立
+    bool Connected() const;
+    // 该连接上的服务端是否已确认能按id分发此方法
+    bool MethodIdConfirmed(uint32_t methodId) const;
+    // 没有在途请求
+    bool Idle() const;
+
+private:
+    // 连接建立/断开回调
+    void OnConnection(const muduo::net::TcpConnectionPtr &conn);
+    // 读回调，按帧解出响应并回调对应请求
+    void OnMessage(const muduo::net::TcpConnectionPtr &conn, muduo::net::Buffer *buffer, muduo::Timestamp);
+    // 连接断开，所有未完成的请求失败
+    void FailAll(const std::string &errText);
+    // 丢弃尚未发出的请求帧，调用方持有_mutex
+    void DropUnsent(uint64_t requestId);
+
+    // 在途请求：回调及其超时定时器，请求结束时取消定时器
+    struct PendingCall
+    {
+        ResponseCallback cb;
+        muduo::net::TimerId timer;
+    };
+
+    muduo::net::EventLoop *_loop;
+    muduo::net::TcpClient _client;
+    mutable std::mutex _mutex;
+    muduo::net::TcpConnectionPtr _conn;
+    std::unordered_map<uint64_t, PendingCall> _pending;      // 在途请求
+    std::vector<std::pair<uint64_t, std::string>> _unsent;    // 连接建立前待发送的帧 request_id => frame
+    std::unordered_set<uint32_t> _confirmedMethodIds;         // 服务端在响应中确认过的方法id，断线后清空
+};
+
+// 进程内共享的连接池：每个服务节点一条长连接，全部连接由一个IO线程驱动
+class MprpcConnectionPool
+{
+public:
+    static MprpcConnectionPool &GetInstance();
+
+    // 获取到ip:port的连接，不存在时创建并发起连接
+    std::shared_ptr<MprpcConnection> GetConnection(const std::string &ip, uint16_t port);
+    // 生成进程内唯一的请求id
+    uint64_t NextRequestId() { return ++_nextRequestId; }
+    // 驱动所有连接的IO线程
+    muduo::net::EventLoop *GetLoop() const { return _loop; }
+
+private:
+    // 清理间隔
+    static const int kSweepIntervalSec = 30;
+
+    MprpcConnectionPool();
+    // 移除服务目录中已不存在、且未连接也没有在途请求的节点，避免对下线节点无限重连
+    void RemoveStale();
+    MprpcConnectionPool(const MprpcConnectionPool &) = delete;
+    MprpcConnectionPool &operator=(const MprpcConnectionPool &) = delete;
+
+    muduo::net::EventLoopThread _ioThread;
+    muduo::net::EventLoop *_loop;
+    std::mutex _mutex;
+    std::unordered_map<std::string, std::shared_ptr<MprpcConnection>> _connections;
+    std::atomic<uint64_t> _nextRequestId;
+};
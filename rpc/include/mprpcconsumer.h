@@ -2,6 +2,20 @@
 
 #include <google/protobuf/service.h>
 #include<google/protobuf/descriptor.h>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// src/servicePro
+class LoadBalancer;
+class ServiceMonitor;
+// servicedirectory.h
+struct ServiceAddr;
+// 服务节点的熔断器和监控句柄，定义在mprpcconsumer.cpp
+struct MprpcEndpoint;
 
 /*RpcChannel* channel = new MyRpcChannel("remotehost.example.com:1234");
 MyService* service = new MyService::Stub(channel);
@@ -9,15 +23,45 @@ service->MyMethod(request, &response, callback);*/
 class Mprpcchannel : public google::protobuf::RpcChannel
 {
 public:
+    // 通过zk查找服务节点
+    Mprpcchannel();
+    // 直连指定节点，不经过zk
+    Mprpcchannel(const std::string& ip, uint16_t port);
+
     // 所有通过stub代理对象调用的rpc方法，都走到这里了，统一做rpc方法调用的数据数据序列化和网络发送 
+    // done为空时同步阻塞等待响应；done非空时为异步调用，立即返回，完成后在发起调用的EventLoop线程执行done，
+    // 此前response/controller须保持有效，request在返回前已序列化
+    // 截止时间见MprpcController::SetDeadline，剩余时间随请求发给服务端，到期未收到响应时以超时失败
     void CallMethod(const google::protobuf::MethodDescriptor* method,
                           google::protobuf::RpcController* controller, 
                           const google::protobuf::Message* request,
                           google::protobuf::Message* response, 
                           google::protobuf::Closure* done);
+
+    using LoadBalancerFactory = std::function<std::shared_ptr<LoadBalancer>()>;
+    // 设置负载均衡策略，须在发起调用前设置；每个方法的节点集合使用一个均衡器，节点上下线后重建
+    // controller设置了路由键(MprpcController::SetRouteKey)时以路由键选择节点，否则以递增序号选择
+    // 未设置时在节点间轮询
+    void SetLoadBalancer(LoadBalancerFactory factory);
+
+    // 调用方各节点的调用统计，以 ip:port 作为方法名，进程内所有channel共享
+    // 每个节点另有熔断器：连续失败后该节点的调用直接失败，并在均衡时跳过该节点
+    static ServiceMonitor& GetMonitor();
+
 private:
-    // 设置超时
-    void Setimeout(int sockfd, int timeoutSec);
-    // 设置服务端地址
-    bool GetSeverAddr(const std::string& serviceName, const std::string& methodName, std::string& ip, uint16_t& port);
+    // 一个方法当前的节点列表及据此建立的均衡器，建立后不再修改
+    struct Route;
+
+    // 设置服务端地址，同时给出该节点(熔断器和监控句柄)；没有可用节点时返回false并给出原因
+    bool GetSeverAddr(const google::protobuf::MethodDescriptor* method, google::protobuf::RpcController* controller,
+                      std::string& ip, uint16_t& port, std::shared_ptr<MprpcEndpoint>& endpoint, std::string& errText);
+    // 获取方法的均衡器，节点列表变化后重建
+    std::shared_ptr<const Route> GetRoute(const google::protobuf::MethodDescriptor* method, const std::shared_ptr<const std::vector<ServiceAddr>>& addrs);
+
+    std::string _fixedIp;  // 直连节点ip，为空时走zk
+    uint16_t _fixedPort;
+
+    LoadBalancerFactory _balancerFactory;
+    std::shared_mutex _routeMutex;
+    std::unordered_map<const google::protobuf::MethodDescriptor*, std::shared_ptr<const Route>> _routes;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include<google/protobuf/service.h>
+#include<chrono>
 #include<string>
 
 
@@ -17,8 +18,43 @@ public:
     bool IsCanceled() const;
     void NotifyOnCancel(google::protobuf::Closure* callback);
 
+    // 路由键(如用户id)，设置后同一路由键的调用由负载均衡器固定到同一节点
+    void SetRouteKey(int key);
+    bool HasRouteKey() const;
+    int RouteKey() const;
+
+    // 截止时间，随请求发给服务端；服务端开始执行前已超过截止时间的请求直接丢弃
+    // 未设置时继承当前正在执行的rpc方法的截止时间，都没有时使用默认超时
+    void SetTimeout(int timeoutMs);
+    void SetDeadline(std::chrono::steady_clock::time_point deadline);
+    bool HasDeadline() const;
+    std::chrono::steady_clock::time_point Deadline() const;
+
+    // 当前线程正在执行的rpc方法的截止时间，没有时返回false
+    static bool CurrentDeadline(std::chrono::steady_clock::time_point &deadline);
+
 private:
     bool m_failed; //RPC执行过程中的状态；
     std::string m_errText; //执行过程中的错误信息
+    bool m_hasRouteKey; //是否设置了路由键
+    int m_routeKey;
+    bool m_hasDeadline; //是否设置了截止时间
+    std::chrono::steady_clock::time_point m_deadline;
+
+};
+
+// 在作用域内设置当前线程的截止时间，provider执行方法期间使用，方法中同步发起的下游调用据此继承
+// 异步方法在回调中发起的下游调用不在作用域内，需把收到的controller的截止时间设置到下游controller上
+class MprpcDeadlineScope
+{
+public:
+    MprpcDeadlineScope(bool hasDeadline, std::chrono::steady_clock::time_point deadline);
+    ~MprpcDeadlineScope();
+
+private:
+    MprpcDeadlineScope(const MprpcDeadlineScope &) = delete;
+    MprpcDeadlineScope &operator=(const MprpcDeadlineScope &) = delete;
 
+    bool m_prevHasDeadline;
+    std::chrono::steady_clock::time_point m_prevDeadline;
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 执行器配置
+struct MprpcExecutorOptions
+{
+    int threadNum = 0;               // 工作线程数，0表示方法直接在IO线程执行
+    size_t maxQueueSize = 10000;     // 尚未开始执行的请求上限，超过时拒绝
+    int maxConcurrencyPerMethod = 0; // 每个方法同时执行的上限，0表示不限制
+    bool orderedPerConnection = false; // 同一连接的请求按到达顺序逐个执行
+};
+
+/*
+    rpc方法执行器，把方法执行从muduo IO线程中分离出来
+    请求依次经过三道关：同一连接的顺序(可选) -> 方法并发上限 -> 就绪队列，由工作线程取出执行。
+    所有排队状态由一把锁保护；每个方法分别统计排队等待时间和执行时间。
+*/
+class MprpcExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    // 单个方法的统计
+    struct MethodStats
+    {
+        std::string name;
+        uint64_t calls;       // 已执行的请求数
+        uint64_t rejected;    // 因队列满被拒绝的请求数
+        uint64_t queueWaitUs; // 累计排队等待时间
+        uint64_t maxQueueWaitUs;
+        uint64_t execUs;      // 累计执行时间
+        uint64_t maxExecUs;
+    };
+
+    MprpcExecutor();
+    ~MprpcExecutor();
+
+    // 注册方法，返回方法id；须在Start之前完成
+    int RegisterMethod(const std::string &name);
+    // 单独设置某个方法的并发上限，0表示不限制；须在Start之前完成
+    void SetMethodLimit(int methodId, int limit);
+
+    // 按配置启动工作线程
+    void Start(const MprpcExecutorOptions &options);
+    // 停止工作线程，未执行的请求丢弃
+    void Stop();
+    // 是否启用了工作线程
+    bool Enabled() const { return !_workers.empty(); }
+
+    // 提交请求，connKey标识请求所属连接；队列已满时返回false，task不会执行
+    bool Submit(int methodId, uint64_t connKey, Task task);
+
+    // 当前排队(尚未开始执行)的请求数
+    size_t QueueSize() const;
+    // 各方法统计
+    std::vector<MethodStats> GetMethodStats() const;
+    // 以 method_<name>_<指标> 的形式输出统计，与ServiceMonitor::GetStats格式一致
+    void GetStats(std::map<std::string, std::string> &stats) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Item
+    {
+        int methodId;
+        uint64_t connKey;
+        Task task;
+        Clock::time_point enqueueTime;
+    };
+
+    struct Method
+    {
+        std::string name;
+        int limit = 0;
+        int running = 0;         // 已进入就绪队列或正在执行的请求数
+        std::deque<Item> waiting; // 超出并发上限等待的请求
+
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> queueWaitUs{0};
+        std::atomic<uint64_t> maxQueueWaitUs{0};
+        std::atomic<uint64_t> execUs{0};
+        std::atomic<uint64_t> maxExecUs{0};
+    };
+
+    // 工作线程
+    void WorkerLoop();
+    // 请求通过连接顺序检查后进入方法并发检查，调用方持有_mutex
+    void Admit(Item item);
+    // 请求执行完毕，释放并发名额并放行后续请求，调用方持有_mutex
+    void Finish(const Item &item);
+    // 更新最大值
+    static void UpdateMax(std::atomic<uint64_t> &target, uint64_t value);
+
+    MprpcExecutorOptions _options;
+    std::vector<std::unique_ptr<Method>> _methods;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::deque<Item> _ready;                                  // 就绪队列
+    std::unordered_map<uint64_t, std::deque<Item>> _strands; // 有序模式下有请求在处理的连接 => 其后排队的请求
+    size_t _pending;                                          // 尚未开始执行的请求数
+    bool _running;
+    std::vector<std::thread> _workers;
+};
@@ -13,7 +13,7 @@
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3021011 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -179,7 +179,12 @@ class mpRpcHeader final :
   enum : int {
     kServiceNameFieldNumber = 1,
     kMethodNameFieldNumber = 2,
+    kErrorTextFieldNumber = 6,
+    kRequestIdFieldNumber = 4,
     kArgsSizeFieldNumber = 3,
+    kErrorCodeFieldNumber = 5,
+    kMethodIdFieldNumber = 7,
+    kTimeoutMsFieldNumber = 8,
   };
   // bytes service_name = 1;
   void clear_service_name();
@@ -209,6 +214,29 @@ class mpRpcHeader final :
   std::string* _internal_mutable_method_name();
   public:
 
+  // bytes error_text = 6;
+  void clear_error_text();
+  const std::string& error_text() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_error_text(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_error_text();
+  PROTOBUF_NODISCARD std::string* release_error_text();
+  void set_allocated_error_text(std::string* error_text);
+  private:
+  const std::string& _internal_error_text() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_error_text(const std::string& value);
+  std::string* _internal_mutable_error_text();
+  public:
+
+  // uint64 request_id = 4;
+  void clear_request_id();
+  uint64_t request_id() const;
+  void set_request_id(uint64_t value);
+  private:
+  uint64_t _internal_request_id() const;
+  void _internal_set_request_id(uint64_t value);
+  public:
+
   // uint32 args_size = 3;
   void clear_args_size();
   uint32_t args_size() const;
@@ -218,6 +246,33 @@ class mpRpcHeader final :
   void _internal_set_args_size(uint32_t value);
   public:
 
+  // int32 error_code = 5;
+  void clear_error_code();
+  int32_t error_code() const;
+  void set_error_code(int32_t value);
+  private:
+  int32_t _internal_error_code() const;
+  void _internal_set_error_code(int32_t value);
+  public:
+
+  // fixed32 method_id = 7;
+  void clear_method_id();
+  uint32_t method_id() const;
+  void set_method_id(uint32_t value);
+  private:
+  uint32_t _internal_method_id() const;
+  void _internal_set_method_id(uint32_t value);
+  public:
+
+  // uint32 timeout_ms = 8;
+  void clear_timeout_ms();
+  uint32_t timeout_ms() const;
+  void set_timeout_ms(uint32_t value);
+  private:
+  uint32_t _internal_timeout_ms() const;
+  void _internal_set_timeout_ms(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:mprpc.mpRpcHeader)
  private:
   class _Internal;
@@ -228,7 +283,12 @@ class mpRpcHeader final :
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr service_name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr method_name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_text_;
+    uint64_t request_id_;
     uint32_t args_size_;
+    int32_t error_code_;
+    uint32_t method_id_;
+    uint32_t timeout_ms_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -365,6 +425,136 @@ inline void mpRpcHeader::set_args_size(uint32_t value) {
   // @@protoc_insertion_point(field_set:mprpc.mpRpcHeader.args_size)
 }
 
+// uint64 request_id = 4;
+inline void mpRpcHeader::clear_request_id() {
+  _impl_.request_id_ = uint64_t{0u};
+}
+inline uint64_t mpRpcHeader::_internal_request_id() const {
+  return _impl_.request_id_;
+}
+inline uint64_t mpRpcHeader::request_id() const {
+  // @@protoc_insertion_point(field_get:mprpc.mpRpcHeader.request_id)
+  return _internal_request_id();
+}
+inline void mpRpcHeader::_internal_set_request_id(uint64_t value) {
+  
+  _impl_.request_id_ = value;
+}
+inline void mpRpcHeader::set_request_id(uint64_t value) {
+  _internal_set_request_id(value);
+  // @@protoc_insertion_point(field_set:mprpc.mpRpcHeader.request_id)
+}
+
+// int32 error_code = 5;
+inline void mpRpcHeader::clear_error_code() {
+  _impl_.error_code_ = 0;
+}
+inline int32_t mpRpcHeader::_internal_error_code() const {
+  return _impl_.error_code_;
+}
+inline int32_t mpRpcHeader::error_code() const {
+  // @@protoc_insertion_point(field_get:mprpc.mpRpcHeader.error_code)
+  return _internal_error_code();
+}
+inline void mpRpcHeader::_internal_set_error_code(int32_t value) {
+  
+  _impl_.error_code_ = value;
+}
+inline void mpRpcHeader::set_error_code(int32_t value) {
+  _internal_set_error_code(value);
+  // @@protoc_insertion_point(field_set:mprpc.mpRpcHeader.error_code)
+}
+
+// bytes error_text = 6;
+inline void mpRpcHeader::clear_error_text() {
+  _impl_.error_text_.ClearToEmpty();
+}
+inline const std::string& mpRpcHeader::error_text() const {
+  // @@protoc_insertion_point(field_get:mprpc.mpRpcHeader.error_text)
+  return _internal_error_text();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void mpRpcHeader::set_error_text(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.error_text_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:mprpc.mpRpcHeader.error_text)
+}
+inline std::string* mpRpcHeader::mutable_error_text() {
+  std::string* _s = _internal_mutable_error_text();
+  // @@protoc_insertion_point(field_mutable:mprpc.mpRpcHeader.error_text)
+  return _s;
+}
+inline const std::string& mpRpcHeader::_internal_error_text() const {
+  return _impl_.error_text_.Get();
+}
+inline void mpRpcHeader::_internal_set_error_text(const std::string& value) {
+  
+  _impl_.error_text_.Set(value, GetArenaForAllocation());
+}
+inline std::string* mpRpcHeader::_internal_mutable_error_text() {
+  
+  return _impl_.error_text_.Mutable(GetArenaForAllocation());
+}
+inline std::string* mpRpcHeader::release_error_text() {
+  // @@protoc_insertion_point(field_release:mprpc.mpRpcHeader.error_text)
+  return _impl_.error_text_.Release();
+}
+inline void mpRpcHeader::set_allocated_error_text(std::string* error_text) {
+  if (error_text != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.error_text_.SetAllocated(error_text, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.error_text_.IsDefault()) {
+    _impl_.error_text_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:mprpc.mpRpcHeader.error_text)
+}
+
+// fixed32 method_id = 7;
+inline void mpRpcHeader::clear_method_id() {
+  _impl_.method_id_ = 0u;
+}
+inline uint32_t mpRpcHeader::_internal_method_id() const {
+  return _impl_.method_id_;
+}
+inline uint32_t mpRpcHeader::method_id() const {
+  // @@protoc_insertion_point(field_get:mprpc.mpRpcHeader.method_id)
+  return _internal_method_id();
+}
+inline void mpRpcHeader::_internal_set_method_id(uint32_t value) {
+  
+  _impl_.method_id_ = value;
+}
+inline void mpRpcHeader::set_method_id(uint32_t value) {
+  _internal_set_method_id(value);
+  // @@protoc_insertion_point(field_set:mprpc.mpRpcHeader.method_id)
+}
+
+// uint32 timeout_ms = 8;
+inline void mpRpcHeader::clear_timeout_ms() {
+  _impl_.timeout_ms_ = 0u;
+}
+inline uint32_t mpRpcHeader::_internal_timeout_ms() const {
+  return _impl_.timeout_ms_;
+}
+inline uint32_t mpRpcHeader::timeout_ms() const {
+  // @@protoc_insertion_point(field_get:mprpc.mpRpcHeader.timeout_ms)
+  return _internal_timeout_ms();
+}
+inline void mpRpcHeader::_internal_set_timeout_ms(uint32_t value) {
+  
+  _impl_.timeout_ms_ = value;
+}
+inline void mpRpcHeader::set_timeout_ms(uint32_t value) {
+  _internal_set_timeout_ms(value);
+  // @@protoc_insertion_point(field_set:mprpc.mpRpcHeader.timeout_ms)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
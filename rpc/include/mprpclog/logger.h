@@ -1,54 +1,159 @@
 #pragma once
-#include"lockqueue.h"
-#include"time.h"
-#include"iostream"
+#include<atomic>
+#include<condition_variable>
+#include<cstdarg>
+#include<cstdio>
+#include<cstring>
+#include<ctime>
+#include<iostream>
+#include<memory>
+#include<mutex>
 #include<string>
+#include<thread>
+#include<vector>
 //日志系统
 
-// LOG_INFO("%s %d", arg1, arg2)
-#define LOG_INFO(logmsgformat, ...) \
+enum LogLevel
+{
+    DEBUG, //调试信息
+    INFO, //普通信息
+    ERROR, //错误信息
+};
+
+// 编译期日志级别，低于该级别的日志连同参数求值一起被编译器删除
+// 例如 -DMPRPC_LOG_MIN_LEVEL=1 去掉所有LOG_DEBUG
+#ifndef MPRPC_LOG_MIN_LEVEL
+#define MPRPC_LOG_MIN_LEVEL 0
+#endif
+
+// 低于运行期日志级别时不求值参数、不格式化
+#define MPRPC_LOG(level, logmsgformat, ...) \
     do \
     { \
-        Logger &logger = Logger::getLOGInstance(); \
-        char msg[1024] ={0}; \
-        snprintf(msg, 1024, logmsgformat, ##__VA_ARGS__); \
-        logger.LOG(INFO, msg); \
+        if ((level) >= MPRPC_LOG_MIN_LEVEL && Logger::IsEnabled(level)) \
+        { \
+            Logger::getLOGInstance().Log(level, logmsgformat, ##__VA_ARGS__); \
+        } \
     } while(0)
 
-#define LOG_ERROR(logmsgformat, ...) \
+// 热路径采样：每个调用点在每个线程上每n次只写第一次
+#define MPRPC_LOG_EVERY_N(level, n, logmsgformat, ...) \
     do \
     { \
-        Logger &logger = Logger::getLOGInstance(); \
-        char msg[1024] ={0}; \
-        snprintf(msg, 1024, logmsgformat, ##__VA_ARGS__); \
-        logger.LOG(ERROR, msg); \
-    }while(0);
+        if ((level) >= MPRPC_LOG_MIN_LEVEL && Logger::IsEnabled(level)) \
+        { \
+            static thread_local unsigned int mprpcLogCount = 0; \
+            if (mprpcLogCount++ % (n) == 0) \
+            { \
+                Logger::getLOGInstance().Log(level, logmsgformat, ##__VA_ARGS__); \
+            } \
+        } \
+    } while(0)
 
+// LOG_INFO("%s %d", arg1, arg2)
+#define LOG_DEBUG(logmsgformat, ...) MPRPC_LOG(DEBUG, logmsgformat, ##__VA_ARGS__)
+#define LOG_INFO(logmsgformat, ...) MPRPC_LOG(INFO, logmsgformat, ##__VA_ARGS__)
+#define LOG_ERROR(logmsgformat, ...) MPRPC_LOG(ERROR, logmsgformat, ##__VA_ARGS__)
 
-enum LogLevel
+// LOG_ERROR_EVERY_N(100, "executor queue is full, reject %s", name)
+#define LOG_INFO_EVERY_N(n, logmsgformat, ...) MPRPC_LOG_EVERY_N(INFO, n, logmsgformat, ##__VA_ARGS__)
+#define LOG_ERROR_EVERY_N(n, logmsgformat, ...) MPRPC_LOG_EVERY_N(ERROR, n, logmsgformat, ##__VA_ARGS__)
+
+// 缓冲区写满且积压的缓冲区达到上限时的处理方式
+enum LogFullPolicy
 {
-    INFO, //普通信息
-    ERROR, //错误信息
+    LOG_DROP,  //丢弃新日志，写线程补记丢弃条数
+    LOG_BLOCK, //阻塞写日志的线程，直到写线程腾出缓冲区
 };
 
+// 日志配置
+struct LoggerOptions
+{
+    std::string baseName = "log";            // 文件名 年-月-日-baseName[.序号].txt
+    size_t rollSize = 64 * 1024 * 1024;      // 单个文件的大小上限，超过后换新文件
+    int flushIntervalMs = 1000;              // 写线程至少每隔这么久写一次文件并fflush
+    size_t maxPendingBuffers = 16;           // 等待写入文件的缓冲区上限
+    LogFullPolicy fullPolicy = LOG_DROP;
+};
 
+/*
+    异步日志，双缓冲
+    写日志的线程把格式化好的一行追加到当前缓冲区(4MB)，只有缓冲区写满时才唤醒写线程；
+    写线程按flushIntervalMs定时醒来，把写满的缓冲区连同当前缓冲区一起换走，在锁外批量fwrite到一直打开的文件，
+    写完的缓冲区还回备用，稳定后不再分配内存。文件按日期和大小滚动。
+*/
 class Logger
 {
 public:
     //获取日志接口
     static Logger& getLOGInstance();
-    //设置日志级别
-    //void setLogLevel(LogLevel);
-    //获取日志级别
-    //std::string getLogLevel();
+    //设置日志配置，写线程在下一轮生效
+    void SetOptions(const LoggerOptions &options);
+    //设置运行期日志级别，默认INFO
+    static void SetLogLevel(LogLevel level) { _level.store(level, std::memory_order_relaxed); }
+    //获取运行期日志级别
+    static LogLevel GetLogLevel() { return static_cast<LogLevel>(_level.load(std::memory_order_relaxed)); }
+    //该级别的日志是否需要写
+    static bool IsEnabled(LogLevel level) { return level >= _level.load(std::memory_order_relaxed); }
+    //写日志，printf格式，直接格式化到线程的行缓冲区
+    void Log(LogLevel level, const char *format, ...) __attribute__((format(printf, 3, 4)));
     //写日志
     void LOG(LogLevel level, std::string msg);
+    //把已写入缓冲区的日志全部写入文件后返回
+    void Flush();
+    //因缓冲区满被丢弃的日志条数
+    uint64_t Dropped() const { return _dropped; }
 
 private:
-    int _loglevel; //日志级别
-    LockQueue<std::pair<LogLevel, std::string>> _lckQue; //日志缓冲队列
+    static const size_t kBufferSize = 4 * 1024 * 1024;
+    static const size_t kMaxLineSize = 4096;
+
+    // 定长日志缓冲区
+    class Buffer
+    {
+    public:
+        Buffer() : _data(new char[kBufferSize]), _len(0) {}
+        size_t Avail() const { return kBufferSize - _len; }
+        void Append(const char *data, size_t len) { memcpy(_data.get() + _len, data, len); _len += len; }
+        const char *Data() const { return _data.get(); }
+        size_t Length() const { return _len; }
+        void Reset() { _len = 0; }
+    private:
+        std::unique_ptr<char[]> _data;
+        size_t _len;
+    };
+    using BufferPtr = std::unique_ptr<Buffer>;
 
     Logger();
     Logger(const Logger&) = delete;
     Logger(Logger&&) = delete;
-};
\ No newline at end of file
+
+    // 追加一行到当前缓冲区
+    void Append(const char *line, size_t len);
+    // 写线程
+    void WriteLoop();
+    // 把一批缓冲区写入文件，按需滚动文件
+    void WriteBuffers(std::vector<BufferPtr> &buffers, const LoggerOptions &options);
+    // 打开当天的日志文件，超过大小时使用下一个序号
+    void RollFile(const struct tm &nowtm, const LoggerOptions &options);
+
+    static std::atomic<int> _level;
+
+    std::mutex _mutex;
+    std::condition_variable _cond;     // 通知写线程
+    std::condition_variable _freeCond; // 阻塞策略下通知生产者有空闲缓冲区，Flush也在此等待
+    BufferPtr _current;                // 正在写入的缓冲区
+    std::vector<BufferPtr> _full;      // 写满待写入文件的缓冲区
+    std::vector<BufferPtr> _spare;     // 空闲缓冲区
+    LoggerOptions _options;
+    uint64_t _flushRequested;          // Flush请求序号
+    uint64_t _flushDone;               // 写线程已完成的Flush序号
+    std::atomic<uint64_t> _dropped;
+
+    // 以下仅写线程访问
+    FILE *_file;
+    size_t _fileSize;
+    int _fileDay;   // 当前文件的日期 年*10000+月*100+日
+    int _fileIndex; // 同一天内的文件序号
+    uint64_t _droppedReported; // 已在文件中补记的丢弃条数
+};
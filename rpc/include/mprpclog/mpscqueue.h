@@ -0,0 +1,329 @@
+#pragma once
+
+#include<atomic>
+#include<condition_variable>
+#include<cstddef>
+#include<cstdint>
+#include<mutex>
+#include<new>
+#include<thread>
+#include<utility>
+#include<vector>
+
+/*
+    有界无锁队列，多个生产者，单个消费者
+    每个槽位带序号：生产者CAS抢占_tail上的位置，原地构造元素后发布序号；消费者按序号判断槽位是否可读，
+    可以一次取出一批。元素只移动不拷贝，支持只能移动的类型。
+    阻塞策略：消费者队列空时先自旋重试，之后才在条件变量上睡眠并设置_consumerWaiting，
+    生产者只有看到该标志时才加锁唤醒，消费者忙碌时入队没有系统调用。
+    队列满时Push同样先自旋，再睡眠等待消费者腾出槽位。
+    Close在_tail上原子地置关闭位，之后生产者的CAS必然失败；关闭前已抢到位置的元素消费者仍会取完。
+*/
+template<typename T>
+class MpscQueue
+{
+public:
+    // 容量向上取整为2的幂
+    explicit MpscQueue(size_t capacity);
+    ~MpscQueue();
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue &operator=(const MpscQueue&) = delete;
+
+    // 入队，队列满或已关闭时返回false，data保持不变
+    bool TryPush(T &&data);
+    // 入队，队列满时阻塞直到有空位；已关闭时返回false，data保持不变
+    bool Push(T &&data);
+
+    // 消费者：取出最多maxCount个元素追加到out，不阻塞，返回取出的个数
+    size_t TryPopBatch(std::vector<T> &out, size_t maxCount);
+    // 消费者：至少取出一个元素才返回；Close后队列为空时返回0
+    size_t PopBatch(std::vector<T> &out, size_t maxCount);
+
+    // 关闭队列，唤醒消费者和阻塞在Push上的生产者；之后的入队都失败
+    // 关闭前已入队的元素消费者仍会取完
+    void Close();
+
+    size_t Capacity() const { return _capacity; }
+    // 近似长度，供统计使用
+    size_t SizeApprox() const;
+
+private:
+    static const int kSpinCount = 64;
+    // _tail的最高位表示队列已关闭
+    static const size_t kClosedBit = ~(~static_cast<size_t>(0) >> 1);
+
+    struct Slot
+    {
+        std::atomic<size_t> _seq;
+        alignas(T) unsigned char _storage[sizeof(T)];
+
+        T *Ptr() { return reinterpret_cast<T*>(_storage); }
+    };
+
+    static size_t RoundUpPowerOfTwo(size_t n);
+    // 队头是否有可读元素，仅消费者调用
+    bool Readable() const;
+    // 已关闭：取出关闭前入队的元素，生产者尚未发布完的等待其发布；全部取完返回0
+    size_t DrainClosed(std::vector<T> &out, size_t maxCount);
+    // 生产者发布元素后，消费者在睡眠时唤醒它
+    void WakeConsumer();
+    // 消费者腾出槽位后，唤醒因队列满而睡眠的生产者
+    void WakeProducers();
+
+    const size_t _capacity;
+    const size_t _mask;
+    Slot *_slots;
+
+    // 生产者和消费者各自修改的位置分别独占缓存行，避免伪共享
+    alignas(64) std::atomic<size_t> _tail; // 下一个入队位置，生产者CAS推进；最高位为关闭位
+    alignas(64) std::atomic<size_t> _head; // 下一个出队位置，只有消费者写
+    alignas(64) std::atomic<bool> _consumerWaiting;
+    std::atomic<int> _producersWaiting;
+    std::atomic<bool> _closed;
+
+    std::mutex _mutex;                 // 消费者睡眠
+    std::condition_variable _notEmpty;
+    std::mutex _fullMutex;             // 队列满时生产者睡眠
+    std::condition_variable _notFull;
+};
+
+template<typename T>
+MpscQueue<T>::MpscQueue(size_t capacity)
+    : _capacity(RoundUpPowerOfTwo(capacity)),
+      _mask(_capacity - 1),
+      _slots(new Slot[_capacity]),
+      _tail(0),
+      _head(0),
+      _consumerWaiting(false),
+      _producersWaiting(0),
+      _closed(false)
+{
+    for (size_t i = 0; i < _capacity; ++i)
+    {
+        _slots[i]._seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    // 析构队列中剩余的元素
+    size_t head = _head.load(std::memory_order_relaxed);
+    while (Readable())
+    {
+        _slots[head & _mask].Ptr()->~T();
+        ++head;
+        _head.store(head, std::memory_order_relaxed);
+    }
+    delete[] _slots;
+}
+
+template<typename T>
+size_t MpscQueue<T>::RoundUpPowerOfTwo(size_t n)
+{
+    size_t capacity = 2;
+    while (capacity < n)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// 多个生产者并发入队
+template<typename T>
+bool MpscQueue<T>::TryPush(T &&data)
+{
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    Slot *slot;
+    for (;;)
+    {
+        if (pos & kClosedBit)
+        {
+            return false;
+        }
+        slot = &_slots[pos & _mask];
+        size_t seq = slot->_seq.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            // 槽位空闲，抢占该位置
+            if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 槽位中还是上一圈未取走的元素，队列已满
+            return false;
+        }
+        else
+        {
+            // 位置已被其他生产者抢占
+            pos = _tail.load(std::memory_order_relaxed);
+        }
+    }
+    new (slot->_storage) T(std::move(data));
+    slot->_seq.store(pos + 1, std::memory_order_release);
+    WakeConsumer();
+    return true;
+}
+
+template<typename T>
+bool MpscQueue<T>::Push(T &&data)
+{
+    for (int i = 0; i < kSpinCount; ++i)
+    {
+        if (TryPush(std::move(data)))
+        {
+            return true;
+        }
+        if (_closed.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    // 先登记再重试，保证消费者腾出槽位或关闭队列时能看到登记
+    bool pushed = false;
+    _producersWaiting.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(_fullMutex);
+        while (!(pushed = TryPush(std::move(data))) && !_closed.load(std::memory_order_acquire))
+        {
+            _notFull.wait(lock);
+        }
+    }
+    _producersWaiting.fetch_sub(1);
+    return pushed;
+}
+
+// 只有消费者线程调用
+template<typename T>
+size_t MpscQueue<T>::TryPopBatch(std::vector<T> &out, size_t maxCount)
+{
+    size_t head = _head.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (count < maxCount)
+    {
+        Slot &slot = _slots[head & _mask];
+        if (slot._seq.load(std::memory_order_acquire) != head + 1)
+        {
+            break;
+        }
+        T *data = slot.Ptr();
+        out.push_back(std::move(*data));
+        data->~T();
+        // 槽位留给下一圈的生产者
+        slot._seq.store(head + _capacity, std::memory_order_release);
+        ++head;
+        ++count;
+    }
+    if (count > 0)
+    {
+        _head.store(head, std::memory_order_relaxed);
+        WakeProducers();
+    }
+    return count;
+}
+
+template<typename T>
+size_t MpscQueue<T>::PopBatch(std::vector<T> &out, size_t maxCount)
+{
+    for (;;)
+    {
+        for (int i = 0; i < kSpinCount; ++i)
+        {
+            size_t count = TryPopBatch(out, maxCount);
+            if (count > 0)
+            {
+                return count;
+            }
+            if (_closed.load(std::memory_order_acquire))
+            {
+                // 关闭前入队的元素仍然取完
+                return DrainClosed(out, maxCount);
+            }
+            std::this_thread::yield();
+        }
+
+        // 先设置等待标志再检查队列，与WakeConsumer中的fence配对，不会错过唤醒
+        _consumerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [this]() { return Readable() || _closed.load(std::memory_order_acquire); });
+        }
+        _consumerWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+size_t MpscQueue<T>::DrainClosed(std::vector<T> &out, size_t maxCount)
+{
+    // 关闭位置上后_tail不再变化
+    size_t end = _tail.load(std::memory_order_acquire) & ~kClosedBit;
+    while (_head.load(std::memory_order_relaxed) != end)
+    {
+        size_t count = TryPopBatch(out, maxCount);
+        if (count > 0)
+        {
+            return count;
+        }
+        // 生产者已抢到位置但还没发布
+        std::this_thread::yield();
+    }
+    return 0;
+}
+
+template<typename T>
+void MpscQueue<T>::Close()
+{
+    _tail.fetch_or(kClosedBit);
+    _closed.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _notEmpty.notify_all();
+    }
+    std::lock_guard<std::mutex> lock(_fullMutex);
+    _notFull.notify_all();
+}
+
+template<typename T>
+size_t MpscQueue<T>::SizeApprox() const
+{
+    size_t tail = _tail.load(std::memory_order_relaxed) & ~kClosedBit;
+    size_t head = _head.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+template<typename T>
+bool MpscQueue<T>::Readable() const
+{
+    size_t head = _head.load(std::memory_order_relaxed);
+    return _slots[head & _mask]._seq.load(std::memory_order_acquire) == head + 1;
+}
+
+template<typename T>
+void MpscQueue<T>::WakeConsumer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_consumerWaiting.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _notEmpty.notify_one();
+    }
+}
+
+template<typename T>
+void MpscQueue<T>::WakeProducers()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_producersWaiting.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(_fullMutex);
+        _notFull.notify_all();
+    }
+}
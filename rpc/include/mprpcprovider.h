@@ -2,44 +2,107 @@
 #include "google/protobuf/service.h"
 #include <google/protobuf/descriptor.h>
 #include <unordered_map>
+#include <vector>
 
 #include <muduo/net/EventLoop.h>
 #include <muduo/net/InetAddress.h>
 #include <muduo/net/TcpServer.h>
 #include <muduo/net/TcpConnection.h>
 #include <functional>
+#include <memory>
 
 #include<zookeeperutil.h>
 
 #include"mprpcheader.pb.h"
+#include"mprpcexecutor.h"
+#include"mprpcarena.h"
+
+// src/servicePro/monitor.h
+class ServiceMonitor;
 
 // 框架提供的专门发布rpc服务的网络对象类
 class MprpcProvider
 {
 public:
+    // 框架层错误码，放在响应header的error_code中
+    enum ErrorCode
+    {
+        kServiceNotFound = 1,
+        kMethodNotFound,
+        kRequestParseError,
+        kResponseSerializeError,
+        kServerBusy,
+        kUnknownMethodId, // 请求只带方法id而服务端不认识，调用方应带上服务名和方法名重试
+        kDeadlineExceeded, // 开始执行前已超过调用方的截止时间，方法未执行
+    };
+
+    MprpcProvider();
+    ~MprpcProvider();
+
     // 发布服务接口
     void NotifyService(google::protobuf::Service *service);
     // 开启节点 提供RPC服务
     void StartMprpc();
+    // 设置方法执行器，未设置时从配置文件读取；须在StartMprpc之前调用
+    void SetExecutorOptions(const MprpcExecutorOptions &options);
+    // 单独设置某个方法的并发上限，须在NotifyService之后、StartMprpc之前调用
+    void SetMethodConcurrency(const std::string &serviceName, const std::string &methodName, int limit);
+    // 方法执行器，可从中获取排队和执行统计
+    const MprpcExecutor &GetExecutor() const { return _executor; }
+    // 各方法的调用统计，方法名为 service.method，延迟从收到请求到发出响应
+    ServiceMonitor &GetMonitor() { return *_monitor; }
    
 private:
     muduo::net::EventLoop _event_loop;
 
+    // 方法信息
+    struct MethodInfo
+    {
+        google::protobuf::Service *_service;                   // 所属服务对象
+        const google::protobuf::MethodDescriptor *_descriptor; // 方法描述
+        int _executorId;                                       // 在执行器中的方法id
+        uint32_t _methodId;                                    // 协议中的方法id
+        std::string _name;                                     // service.method，用于统计
+        int _monitorId;                                        // 在监控中的方法句柄
+    };
     // 服务类型信息(方法信息)
     struct MethodStruct
     {
         google::protobuf::Service *_service;                                                  // 服务对象(服务名称)
-        std::unordered_map<std::string, const google::protobuf::MethodDescriptor*> _methodInfoMap; // 服务方法
+        std::unordered_map<std::string, MethodInfo> _methodInfoMap; // 服务方法
     };
     // 服务对象及其方法信息 <service methodstruct>
     std::unordered_map<std::string, MethodStruct> _serviceInfo;
+    // 方法id => 方法信息，按id排序的扁平分发表，冲突的id对应nullptr
+    std::vector<std::pair<uint32_t, const MethodInfo *>> _methodTable;
+
+    MprpcExecutorOptions _executorOptions;
+    bool _executorConfigured = false; // 是否通过SetExecutorOptions设置过
+
+    // 一次rpc调用的上下文，和request、response一起分配在调用arena上
+    class RpcCall;
+    // 调用arena回收池，响应发出后整体归还
+    MprpcArenaPool _arenaPool;
+    // 方法调用统计
+    std::unique_ptr<ServiceMonitor> _monitor;
+
+    // 方法执行器，把阻塞的方法执行和IO线程分开
+    // 工作线程和排队的调用使用上面的arena池和监控，必须最后声明、最先析构
+    MprpcExecutor _executor;
+
+    // 从配置文件读取执行器配置
+    void LoadExecutorOptions();
 
     // 连接回调
     void OnConnection(const muduo::net::TcpConnectionPtr &);
     // 读写回调
     void OnMessage(const muduo::net::TcpConnectionPtr &, muduo::net::Buffer *, muduo::Timestamp);
-     // Closure的回调操作，用于序列化rpc的响应和网络发送
-    void SendmprpcResponse(const muduo::net::TcpConnectionPtr &conn, google::protobuf::Message *response);
-    // 解析header头
-    bool Paresrpcheader(const std::string& headerstr, std::string& serviceName, std::string& methodName, uint32_t &);
+    // 处理一个完整的rpc请求
+    void HandleRequest(const muduo::net::TcpConnectionPtr &conn, const mprpc::mpRpcHeader &header, const char *args, size_t argsSize);
+    // 按方法id查分发表，不存在时返回nullptr
+    const MethodInfo *FindMethod(uint32_t methodId) const;
+     // Closure的回调操作，用于序列化rpc的响应和网络发送，methodId非0时在响应中带回；返回响应是否序列化成功
+    bool SendmprpcResponse(const muduo::net::TcpConnectionPtr &conn, google::protobuf::Message *response, uint64_t requestId, uint32_t methodId);
+    // 回复框架层错误
+    void SendErrorResponse(const muduo::net::TcpConnectionPtr &conn, uint64_t requestId, int errorCode, const std::string &errorText, uint32_t methodId = 0);
 };
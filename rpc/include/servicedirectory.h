@@ -0,0 +1,80 @@
+#pragma once
+
+#include "zookeeperutil.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 一个服务节点的地址
+struct ServiceAddr
+{
+    std::string ip;
+    uint16_t port;
+};
+
+/*
+    进程内共享的服务目录：/service/method => 提供该方法的全部节点
+    整个进程只持有一个zk会话。首次查询时从zk读取子节点列表并设置watch，
+    之后的查询只读本地缓存；节点上下线触发watch后删除对应缓存项，下次查询重新读取并再次设置watch。
+    没有节点或zk不可用的结果同样缓存，在kNegativeCacheMs内直接返回，避免每次调用都同步访问zk。
+    zk会话由后台线程维护，查询路径上不等待建立连接：会话不可用时直接失败，已有的缓存项继续使用旧数据，
+    会话过期后缓存项标记为过期但保留地址，重新连上后再读取并设置watch。
+    地址列表不可变，查询方拿到shared_ptr后在锁外使用。
+*/
+class ServiceDirectory
+{
+public:
+    using AddrList = std::shared_ptr<const std::vector<ServiceAddr>>;
+
+    static ServiceDirectory &GetInstance();
+
+    // 查询提供service.method的全部节点，服务不存在或zk不可用时返回nullptr
+    AddrList Lookup(const std::string &serviceName, const std::string &methodName);
+    // 缓存的方法数
+    size_t Size() const;
+    // 缓存中出现的全部节点 ip:port
+    std::unordered_set<std::string> Endpoints() const;
+
+private:
+    ServiceDirectory();
+    ~ServiceDirectory();
+    ServiceDirectory(const ServiceDirectory &) = delete;
+    ServiceDirectory &operator=(const ServiceDirectory &) = delete;
+
+    // 没有节点的查询结果的缓存时间
+    static const int kNegativeCacheMs = 1000;
+
+    // 缓存项，有节点的列表一直有效直到watch触发或会话过期，空列表到expire过期
+    struct Entry
+    {
+        AddrList addrs;
+        std::chrono::steady_clock::time_point expire;
+    };
+
+    // 从zk读取节点列表并设置watch，没有节点时返回空列表；zk不可用或出错时返回false
+    bool Load(const std::string &path, AddrList &addrs);
+    // zk事件线程中的节点变化通知
+    void OnWatch(const std::string &path);
+    // 后台线程：会话过期或句柄不存在时重新发起连接
+    void SessionLoop();
+
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<std::string, Entry> _cache;    // 方法路径 => 节点列表
+    uint64_t _version;                                // 每次失效递增，避免把旧数据写回缓存
+
+    std::mutex _sessionMutex;
+    std::condition_variable _sessionCond; // 会话过期或退出时唤醒后台线程
+    bool _sessionLost;
+    bool _running;
+    std::thread _sessionThread; // 在构造函数体中启动
+
+    std::mutex _zkMutex; // 串行化zk句柄的替换和同步读取
+    ZkClient _zkcli;     // 最先析构，关闭句柄时的回调仍能访问上面的成员
+};
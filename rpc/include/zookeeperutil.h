@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
 #include <zookeeper/zookeeper.h>
 #include <semaphore.h>
 #include"mprpcapplication.h"
@@ -8,18 +11,43 @@
 class ZkClient
 {
 public:
+    // 节点变化通知，path为发生变化的节点；会话过期时path为空，所有watch都已失效
+    // 在zk的事件线程中执行，回调内不能再发起同步zk调用
+    using WatchCallback = std::function<void(const std::string &path)>;
+
     ZkClient();
     ~ZkClient();
-    // zkclient启动连接zkserver
+    // zkclient启动连接zkserver，最多等待10秒
     void Start();
+    // 发起连接后立即返回，会话建立后Connected()变为true；需要与其他调用互斥
+    void StartAsync();
     // 在zkserver上根据指定的path创建znode节点
     void Create(const char *path, const char *data, int datalen, int state=0);
-    // 根据参数指定的znode节点路径，获取znode节点的值
-    std::string GetData(const char *path);
+    // 根据参数指定的znode节点路径，获取znode节点的值，watch为true时节点变化后通过WatchCallback通知
+    std::string GetData(const char *path, bool watch = false);
+    // 获取子节点列表，节点不存在或出错时返回false，watch含义同GetData
+    bool GetChildren(const char *path, std::vector<std::string> &children, bool watch = false);
+    // 节点是否存在，出错时返回false；watch为true时节点不存在也会设置watch，节点创建后通知
+    bool Exists(const char *path, bool watch = false);
+    // 设置节点变化通知，需在Start之前设置
+    void SetWatchCallback(WatchCallback cb) { _watchCallback = std::move(cb); }
+    // 会话可用：已连接且未过期
+    bool Connected() const { return _zhandle != nullptr && _connected && !_expired; }
+    // 句柄不存在或会话已过期，需要重新Start；断线重连期间zk客户端会自行恢复，不需要重建
+    bool NeedRestart() const { return _zhandle == nullptr || _expired; }
 
 private:
+    friend void global_watcher(zhandle_t *zh, int type, int state, const char *path, void *watcherCtx);
+
     // 客户端句柄
     zhandle_t *_zhandle;
+    // 等待连接建立
+    sem_t _sem;
+    // 会话已过期，需要重新Start
+    std::atomic<bool> _expired;
+    // 与zkserver保持连接，断线重连期间为false
+    std::atomic<bool> _connected;
+    WatchCallback _watchCallback;
 
     // 重连
     void Reconnect();
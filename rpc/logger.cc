@@ -1,58 +1,291 @@
 #include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+// 空闲缓冲区最多保留的个数，突发写入时多分配的缓冲区写完后释放
+static const size_t kMaxSpareBuffers = 4;
+
+std::atomic<int> Logger::_level(INFO);
+
+// 进程退出前把缓冲区中的日志写入文件
+static void FlushAtExit()
+{
+    Logger::getLOGInstance().Flush();
+}
 
 // 获取日志接口
 Logger& Logger::getLOGInstance()
 {
-    static Logger logger;
-    return logger;
+    // 不析构：其他静态对象析构时仍可能写日志
+    static Logger *logger = new Logger();
+    return *logger;
 }
 
 Logger::Logger()
+    : _current(new Buffer),
+      _flushRequested(0),
+      _flushDone(0),
+      _dropped(0),
+      _file(nullptr),
+      _fileSize(0),
+      _fileDay(0),
+      _fileIndex(0),
+      _droppedReported(0)
 {
+    _spare.emplace_back(new Buffer);
+    _spare.emplace_back(new Buffer);
     //启动写日志线程
-    std::thread writrLogTask([&](){
-        for(;;)
+    std::thread writeLogTask(&Logger::WriteLoop, this);
+    writeLogTask.detach();
+    std::atexit(FlushAtExit);
+}
+
+// 设置日志配置
+void Logger::SetOptions(const LoggerOptions &options)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _options = options;
+}
+
+// 写日志：时间 =>[级别]内容
+void Logger::Log(LogLevel level, const char *format, ...)
+{
+    // 每个线程一个行缓冲区，时间前缀每秒只格式化一次
+    thread_local char line[kMaxLineSize];
+    thread_local time_t lastSecond = 0;
+    thread_local char timePrefix[32];
+    thread_local size_t timeLen = 0;
+
+    time_t now = time(nullptr);
+    if (now != lastSecond)
+    {
+        lastSecond = now;
+        struct tm nowtm;
+        localtime_r(&now, &nowtm);
+        timeLen = snprintf(timePrefix, sizeof(timePrefix), "%d:%d:%d =>", nowtm.tm_hour, nowtm.tm_min, nowtm.tm_sec);
+    }
+    size_t len = timeLen;
+    memcpy(line, timePrefix, len);
+    const char *tag = level == ERROR ? "[ERROR]" : (level == INFO ? "[INFO]" : "[DEBUG]");
+    size_t tagLen = strlen(tag);
+    memcpy(line + len, tag, tagLen);
+    len += tagLen;
+
+    // 超长的内容截断，留一个字节给换行
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(line + len, kMaxLineSize - len, format, args);
+    va_end(args);
+    if (n > 0)
+    {
+        len += std::min(static_cast<size_t>(n), kMaxLineSize - len - 1);
+    }
+    line[len++] = '\n';
+    Append(line, len);
+}
+
+// 写日志
+void Logger::LOG(LogLevel level, std::string msg)
+{
+    if (!IsEnabled(level))
+    {
+        return;
+    }
+    Log(level, "%s", msg.c_str());
+}
+
+// 追加一行到当前缓冲区
+void Logger::Append(const char *line, size_t len)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_current->Avail() < len)
+    {
+        // 当前缓冲区已满，积压达到上限时按策略丢弃或等待
+        while (_full.size() >= _options.maxPendingBuffers)
+        {
+            if (_options.fullPolicy == LOG_DROP)
+            {
+                ++_dropped;
+                return;
+            }
+            _freeCond.wait(lock);
+        }
+        if (_current->Avail() < len)
         {
-            time_t now = time(nullptr);
-            tm *nowtm = localtime(&now);
+            _full.push_back(std::move(_current));
+            if (!_spare.empty())
+            {
+                _current = std::move(_spare.back());
+                _spare.pop_back();
+            }
+            else
+            {
+                _current.reset(new Buffer);
+            }
+            // 只有缓冲区写满时才唤醒写线程
+            _cond.notify_one();
+        }
+    }
+    _current->Append(line, len);
+}
 
-            char fileName[128];
-            sprintf(fileName, "%d-%d-%d-log.txt", nowtm->tm_year+1900, nowtm->tm_mon, nowtm->tm_mday);
+// 把已写入缓冲区的日志全部写入文件后返回
+void Logger::Flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    uint64_t target = ++_flushRequested;
+    _cond.notify_one();
+    _freeCond.wait(lock, [this, target]() { return _flushDone >= target; });
+}
 
-            FILE *pf = fopen(fileName, "a");
-            if(pf == nullptr)
+// 写线程
+void Logger::WriteLoop()
+{
+    std::vector<BufferPtr> buffers;
+    LoggerOptions options;
+    for (;;)
+    {
+        uint64_t flushTarget;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_full.empty() && _flushDone == _flushRequested)
+            {
+                _cond.wait_for(lock, std::chrono::milliseconds(_options.flushIntervalMs));
+            }
+            // 未写满的当前缓冲区也一起取走，日志最多延迟flushIntervalMs写入文件
+            if (_current->Length() > 0)
             {
-                std::cout<< "logger file :" << fileName << " open error!" << std::endl;
-                exit(EXIT_FAILURE);
+                _full.push_back(std::move(_current));
+                if (!_spare.empty())
+                {
+                    _current = std::move(_spare.back());
+                    _spare.pop_back();
+                }
+                else
+                {
+                    _current.reset(new Buffer);
+                }
             }
-            //读日志队列写入LOG
-            std::pair<LogLevel, std::string> msg = _lckQue.Pop();
-            std::string LogMsg = msg.second;
-            std::string Level;
-            switch (msg.first)
+            buffers.swap(_full);
+            flushTarget = _flushRequested;
+            options = _options;
+        }
+
+        // 锁外写文件，写日志的线程只在交换缓冲区时与写线程竞争
+        WriteBuffers(buffers, options);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (BufferPtr &buffer : buffers)
             {
-            case INFO:
-                LogMsg.insert(0, "[INFO]");
-                break;
-            case ERROR:
-                LogMsg.insert(0, "[ERROR]");
-            default:
-                break;
+                if (_spare.size() < kMaxSpareBuffers)
+                {
+                    buffer->Reset();
+                    _spare.push_back(std::move(buffer));
+                }
             }
-            //添加时间
-            char timeMsg[128] = {0};
-            sprintf(timeMsg, "%d:%d:%d =>", nowtm->tm_hour, nowtm->tm_min, nowtm->tm_sec);
-            LogMsg.insert(0, timeMsg);
-            LogMsg.append("\n");
-            fputs(LogMsg.c_str(), pf);
-            fclose(pf);
+            buffers.clear();
+            _flushDone = flushTarget;
         }
-    });
-    writrLogTask.detach();
+        _freeCond.notify_all();
+    }
 }
 
-// 写日志
-void Logger::LOG(LogLevel level, std::string msg)
+// 把一批缓冲区写入文件
+void Logger::WriteBuffers(std::vector<BufferPtr> &buffers, const LoggerOptions &options)
 {
-    _lckQue.Push(std::make_pair(level, msg));
+    time_t now = time(nullptr);
+    struct tm nowtm;
+    localtime_r(&now, &nowtm);
+    int day = (nowtm.tm_year + 1900) * 10000 + (nowtm.tm_mon + 1) * 100 + nowtm.tm_mday;
+
+    bool written = false;
+    for (BufferPtr &buffer : buffers)
+    {
+        if (buffer->Length() == 0)
+        {
+            continue;
+        }
+        if (_file == nullptr || day != _fileDay || _fileSize >= options.rollSize)
+        {
+            RollFile(nowtm, options);
+        }
+        FILE *out = _file != nullptr ? _file : stderr;
+        fwrite(buffer->Data(), 1, buffer->Length(), out);
+        _fileSize += buffer->Length();
+        written = true;
+    }
+
+    // 补记因缓冲区满丢弃的日志条数
+    uint64_t dropped = _dropped.load();
+    if (dropped != _droppedReported)
+    {
+        if (_file == nullptr)
+        {
+            RollFile(nowtm, options);
+        }
+        FILE *out = _file != nullptr ? _file : stderr;
+        int n = fprintf(out, "%d:%d:%d =>[ERROR]logger dropped %lu messages\n", nowtm.tm_hour, nowtm.tm_min, nowtm.tm_sec,
+                        static_cast<unsigned long>(dropped - _droppedReported));
+        _fileSize += n > 0 ? n : 0;
+        _droppedReported = dropped;
+        written = true;
+    }
+    if (written && _file != nullptr)
+    {
+        fflush(_file);
+    }
+}
+
+// 打开当天的日志文件 年-月-日-baseName[.序号].txt
+void Logger::RollFile(const struct tm &nowtm, const LoggerOptions &options)
+{
+    int day = (nowtm.tm_year + 1900) * 10000 + (nowtm.tm_mon + 1) * 100 + nowtm.tm_mday;
+    if (day != _fileDay)
+    {
+        _fileDay = day;
+        _fileIndex = 0;
+    }
+    else if (_file != nullptr)
+    {
+        ++_fileIndex;
+    }
+    if (_file != nullptr)
+    {
+        fclose(_file);
+        _file = nullptr;
+    }
+
+    // 重启后继续追加到当天未写满的文件
+    for (;;)
+    {
+        char fileName[256];
+        if (_fileIndex == 0)
+        {
+            snprintf(fileName, sizeof(fileName), "%d-%02d-%02d-%s.txt",
+                     nowtm.tm_year + 1900, nowtm.tm_mon + 1, nowtm.tm_mday, options.baseName.c_str());
+        }
+        else
+        {
+            snprintf(fileName, sizeof(fileName), "%d-%02d-%02d-%s.%d.txt",
+                     nowtm.tm_year + 1900, nowtm.tm_mon + 1, nowtm.tm_mday, options.baseName.c_str(), _fileIndex);
+        }
+        _file = fopen(fileName, "a");
+        if (_file == nullptr)
+        {
+            std::cout << "logger file :" << fileName << " open error!" << std::endl;
+            return;
+        }
+        fseek(_file, 0, SEEK_END);
+        long size = ftell(_file);
+        _fileSize = size > 0 ? static_cast<size_t>(size) : 0;
+        if (_fileSize < options.rollSize)
+        {
+            return;
+        }
+        fclose(_file);
+        _file = nullptr;
+        ++_fileIndex;
+    }
 }
@@ -46,6 +46,35 @@ void MprpcApplication::Init(int argc, char **argv)
     // std::cout << "rpcserverport:" << _config.LoadConfig("rpcserverport") << std::endl;
     // std::cout << "zookeeperip:" << _config.LoadConfig("zookeeperip") << std::endl;
     // std::cout << "zookeeperport:" << _config.LoadConfig("zookeeperport") << std::endl;
+
+    // 日志级别 loglevel=debug|info|error，默认info
+    std::string value = _config.LoadConfig("loglevel");
+    if (value == "debug")
+    {
+        Logger::SetLogLevel(DEBUG);
+    }
+    else if (value == "error")
+    {
+        Logger::SetLogLevel(ERROR);
+    }
+
+    // 日志配置 logrollmb=64 logflushms=1000 logfullpolicy=drop|block
+    LoggerOptions logOptions;
+    value = _config.LoadConfig("logrollmb");
+    if (!value.empty())
+    {
+        logOptions.rollSize = static_cast<size_t>(atoi(value.c_str())) * 1024 * 1024;
+    }
+    value = _config.LoadConfig("logflushms");
+    if (!value.empty())
+    {
+        logOptions.flushIntervalMs = atoi(value.c_str());
+    }
+    if (_config.LoadConfig("logfullpolicy") == "block")
+    {
+        logOptions.fullPolicy = LOG_BLOCK;
+    }
+    Logger::getLOGInstance().SetOptions(logOptions);
 }
 
 // 框架接口
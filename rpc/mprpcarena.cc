@@ -0,0 +1,55 @@
+#include "mprpcarena.h"
+
+MprpcCallArena::MprpcCallArena()
+    : _arena(MakeOptions(_initialBlock))
+{
+}
+
+google::protobuf::ArenaOptions MprpcCallArena::MakeOptions(char *block)
+{
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block;
+    options.initial_block_size = kInitialBlockSize;
+    // 大消息超出初始内存后按块增长，Reset时释放
+    options.start_block_size = kInitialBlockSize;
+    return options;
+}
+
+MprpcArenaPool::~MprpcArenaPool()
+{
+    for (MprpcCallArena *arena : _idle)
+    {
+        delete arena;
+    }
+}
+
+// 取出一个空闲arena
+MprpcCallArena *MprpcArenaPool::Acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_idle.empty())
+        {
+            MprpcCallArena *arena = _idle.back();
+            _idle.pop_back();
+            return arena;
+        }
+    }
+    return new MprpcCallArena();
+}
+
+// 归还arena
+void MprpcArenaPool::Release(MprpcCallArena *arena)
+{
+    // 在锁外析构对象，request/response的析构不占用池的锁
+    arena->Reset();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_idle.size() < _maxIdle)
+        {
+            _idle.push_back(arena);
+            return;
+        }
+    }
+    delete arena;
+}
@@ -0,0 +1,102 @@
+#include "mprpccodec.h"
+#include "logger.h"
+#include <muduo/net/EventLoop.h>
+#include <arpa/inet.h>
+#include <cstring>
+
+static void WriteUint32(char *dest, uint32_t value)
+{
+    uint32_t be = htonl(value);
+    memcpy(dest, &be, sizeof(be));
+}
+
+static uint32_t ReadUint32(const char *src)
+{
+    uint32_t be = 0;
+    memcpy(&be, src, sizeof(be));
+    return ntohl(be);
+}
+
+// 帧交给IO线程发送
+void MprpcCodec::Send(const muduo::net::TcpConnectionPtr &conn, std::string &&frame)
+{
+    muduo::net::EventLoop *loop = conn->getLoop();
+    if (loop->isInLoopThread())
+    {
+        conn->send(frame);
+        return;
+    }
+    loop->queueInLoop([conn, frame = std::move(frame)]() { conn->send(frame); });
+}
+
+// 方法全名的FNV-1a哈希
+uint32_t MprpcCodec::MethodId(const std::string &fullName)
+{
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : fullName)
+    {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+// 编码一帧追加到out
+bool MprpcCodec::Encode(mprpc::mpRpcHeader &header, const google::protobuf::Message *body, std::string *out)
+{
+    size_t bodyLen = body != nullptr ? body->ByteSizeLong() : 0;
+    header.set_args_size(static_cast<uint32_t>(bodyLen));
+    size_t headerLen = header.ByteSizeLong();
+    size_t frameLen = kLengthSize + headerLen + bodyLen;
+    if (frameLen > kMaxFrameSize)
+    {
+        LOG_ERROR("rpc frame too large: %lu", static_cast<unsigned long>(frameLen));
+        return false;
+    }
+
+    size_t offset = out->size();
+    out->resize(offset + kLengthSize + frameLen);
+    char *p = &(*out)[offset];
+    WriteUint32(p, static_cast<uint32_t>(frameLen));
+    WriteUint32(p + kLengthSize, static_cast<uint32_t>(headerLen));
+    p += 2 * kLengthSize;
+    // ByteSizeLong已缓存大小，按缓存大小直接写入
+    header.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(p));
+    if (body != nullptr)
+    {
+        body->SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(p + headerLen));
+    }
+    return true;
+}
+
+// 从buf开头解出一帧
+MprpcCodec::DecodeResult MprpcCodec::Decode(const muduo::net::Buffer *buf, mprpc::mpRpcHeader *header,
+                                            const char **body, size_t *bodyLen, size_t *frameSize)
+{
+    if (buf->readableBytes() < 2 * kLengthSize)
+    {
+        return kFrameIncomplete;
+    }
+    const char *data = buf->peek();
+    size_t frameLen = ReadUint32(data);
+    size_t headerLen = ReadUint32(data + kLengthSize);
+    if (frameLen < kLengthSize || frameLen > kMaxFrameSize || headerLen > frameLen - kLengthSize)
+    {
+        LOG_ERROR("invalid rpc frame, frame_len:%lu header_len:%lu",
+                  static_cast<unsigned long>(frameLen), static_cast<unsigned long>(headerLen));
+        return kFrameError;
+    }
+    if (buf->readableBytes() < kLengthSize + frameLen)
+    {
+        return kFrameIncomplete;
+    }
+    if (!header->ParseFromArray(data + 2 * kLengthSize, static_cast<int>(headerLen)))
+    {
+        LOG_ERROR("rpc header parse error!");
+        return kFrameError;
+    }
+    *body = data + 2 * kLengthSize + headerLen;
+    *bodyLen = frameLen - kLengthSize - headerLen;
+    *frameSize = kLengthSize + frameLen;
+    return kFrameOk;
+}
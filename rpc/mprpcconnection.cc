@@ -0,0 +1,292 @@
+#include "mprpcconnection.h"
+#include "mprpccodec.h"
+#include "mprpcprovider.h"
+#include "servicedirectory.h"
+#include "logger.h"
+#include <muduo/net/InetAddress.h>
+
+MprpcConnection::MprpcConnection(muduo::net::EventLoop *loop, const std::string &ip, uint16_t port)
+    : _loop(loop),
+      _client(loop, muduo::net::InetAddress(ip, port), "MprpcClient")
+{
+    _client.setConnectionCallback(std::bind(&MprpcConnection::OnConnection, this, std::placeholders::_1));
+    _client.setMessageCallback(std::bind(&MprpcConnection::OnMessage, this,
+                                         std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    // 断开后自动重连
+    _client.enableRetry();
+    _client.connect();
+}
+
+// 发送一帧请求
+void MprpcConnection::Send(uint64_t requestId, std::string frame, ResponseCallback cb, double timeoutSec)
+{
+    muduo::net::TcpConnectionPtr conn;
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_conn)
+        {
+            conn = _conn;
+        }
+        else if (_unsent.size() >= kMaxUnsent)
+        {
+            // 连接长时间建立不起来，不再无限缓存
+            full = true;
+        }
+        else
+        {
+            _unsent.emplace_back(requestId, std::move(frame));
+        }
+        if (!full)
+        {
+            _pending[requestId].cb = std::move(cb);
+        }
+    }
+    if (full)
+    {
+        cb("rpc connection not ready, too many unsent requests", nullptr, 0);
+        return;
+    }
+    if (conn)
+    {
+        // 帧整体移交给IO线程，不再复制
+        MprpcCodec::Send(conn, std::move(frame));
+    }
+
+    // 超时定时器，响应先到时取消；定时器id存入_pending前响应已到达的，在这里取消
+    std::weak_ptr<MprpcConnection> weakSelf(shared_from_this());
+    muduo::net::TimerId timer = _loop->runAfter(timeoutSec, [weakSelf, requestId]() {
+        std::shared_ptr<MprpcConnection> self = weakSelf.lock();
+        if (!self)
+        {
+            return;
+        }
+        ResponseCallback timeoutCb;
+        {
+            std::lock_guard<std::mutex> lock(self->_mutex);
+            auto it = self->_pending.find(requestId);
+            if (it == self->_pending.end())
+            {
+                return;
+            }
+            timeoutCb = std::move(it->second.cb);
+            self->_pending.erase(it);
+            // 调用方已按超时失败，连接建立后不能再把请求发给服务端
+            self->DropUnsent(requestId);
+        }
+        timeoutCb("rpc call timeout!", nullptr, 0);
+    });
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _pending.find(requestId);
+        if (it != _pending.end())
+        {
+            it->second.timer = timer;
+            return;
+        }
+    }
+    _loop->cancel(timer);
+}
+
+// 放弃等待某个请求
+bool MprpcConnection::Cancel(uint64_t requestId)
+{
+    muduo::net::TimerId timer;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _pending.find(requestId);
+        if (it == _pending.end())
+        {
+            return false;
+        }
+        timer = it->second.timer;
+        _pending.erase(it);
+        DropUnsent(requestId);
+    }
+    _loop->cancel(timer);
+    return true;
+}
+
+// 丢弃尚未发出的请求帧
+void MprpcConnection::DropUnsent(uint64_t requestId)
+{
+    for (auto it = _unsent.begin(); it != _unsent.end(); ++it)
+    {
+        if (it->first == requestId)
+        {
+            _unsent.erase(it);
+            return;
+        }
+    }
+}
+
+bool MprpcConnection::Connected() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _conn != nullptr;
+}
+
+bool MprpcConnection::MethodIdConfirmed(uint32_t methodId) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _confirmedMethodIds.count(methodId) > 0;
+}
+
+bool MprpcConnection::Idle() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending.empty();
+}
+
+// 连接建立/断开回调
+void MprpcConnection::OnConnection(const muduo::net::TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+    {
+        conn->setTcpNoDelay(true);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _conn = conn;
+        for (auto &item : _unsent)
+        {
+            conn->send(item.second);
+        }
+        _unsent.clear();
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _conn.reset();
+            // 重连后可能是另一个版本的服务端，重新确认方法id
+            _confirmedMethodIds.clear();
+        }
+        FailAll("rpc connection closed");
+    }
+}
+
+// 读回调 （frameLen + headerLen + header + response）
+void MprpcConnection::OnMessage(const muduo::net::TcpConnectionPtr &conn, muduo::net::Buffer *buffer, muduo::Timestamp)
+{
+    mprpc::mpRpcHeader header;
+    const char *body = nullptr;
+    size_t bodyLen = 0;
+    size_t frameSize = 0;
+    MprpcCodec::DecodeResult result;
+    while ((result = MprpcCodec::Decode(buffer, &header, &body, &bodyLen, &frameSize)) == MprpcCodec::kFrameOk)
+    {
+        ResponseCallback cb;
+        muduo::net::TimerId timer;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // 服务端按id分发成功时在响应中带回方法id，之后的请求可省略服务名和方法名
+            if (header.method_id() != 0)
+            {
+                if (header.error_code() == MprpcProvider::kUnknownMethodId)
+                {
+                    _confirmedMethodIds.erase(header.method_id());
+                }
+                else if (header.error_code() == 0)
+                {
+                    _confirmedMethodIds.insert(header.method_id());
+                }
+            }
+            auto it = _pending.find(header.request_id());
+            if (it != _pending.end())
+            {
+                cb = std::move(it->second.cb);
+                timer = it->second.timer;
+                _pending.erase(it);
+            }
+        }
+        if (cb)
+        {
+            // 在IO线程上直接取消，不再占用定时器队列
+            _loop->cancel(timer);
+            if (header.error_code() != 0)
+            {
+                cb(header.error_text().empty() ? "rpc error" : header.error_text(), nullptr, 0);
+            }
+            else
+            {
+                // 直接在接收缓冲区上解析，不另行拷贝
+                cb("", body, bodyLen);
+            }
+        }
+        buffer->retrieve(frameSize);
+    }
+    if (result == MprpcCodec::kFrameError)
+    {
+        buffer->retrieveAll();
+        conn->shutdown();
+    }
+}
+
+// 所有未完成的请求失败
+void MprpcConnection::FailAll(const std::string &errText)
+{
+    std::unordered_map<uint64_t, PendingCall> pending;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        pending.swap(_pending);
+        _unsent.clear();
+    }
+    for (auto &item : pending)
+    {
+        _loop->cancel(item.second.timer);
+        item.second.cb(errText, nullptr, 0);
+    }
+}
+
+MprpcConnectionPool &MprpcConnectionPool::GetInstance()
+{
+    static MprpcConnectionPool pool;
+    return pool;
+}
+
+MprpcConnectionPool::MprpcConnectionPool()
+    : _ioThread(muduo::net::EventLoopThread::ThreadInitCallback(), "MprpcClientIO"),
+      _loop(_ioThread.startLoop()),
+      _nextRequestId(0)
+{
+    _loop->runEvery(kSweepIntervalSec, [this]() { RemoveStale(); });
+}
+
+// 获取到ip:port的连接
+std::shared_ptr<MprpcConnection> MprpcConnectionPool::GetConnection(const std::string &ip, uint16_t port)
+{
+    std::string key = ip + ":" + std::to_string(port);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _connections.find(key);
+    if (it != _connections.end())
+    {
+        return it->second;
+    }
+    auto conn = std::make_shared<MprpcConnection>(_loop, ip, port);
+    _connections.insert({key, conn});
+    return conn;
+}
+
+// 移除服务目录中已不存在的节点，在IO线程定时执行
+void MprpcConnectionPool::RemoveStale()
+{
+    std::unordered_set<std::string> listed = ServiceDirectory::GetInstance().Endpoints();
+    // 连接在锁外析构
+    std::vector<std::shared_ptr<MprpcConnection>> removed;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto it = _connections.begin(); it != _connections.end();)
+        {
+            // 仍连着的节点可能只是目录缓存尚未重新加载，保留
+            if (listed.count(it->first) == 0 && !it->second->Connected() && it->second->Idle())
+            {
+                LOG_INFO("remove rpc connection to %s, no longer in service directory", it->first.c_str());
+                removed.push_back(std::move(it->second));
+                it = _connections.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
@@ -3,51 +3,291 @@
 #include "mprpcheader.pb.h"
 #include"mprpcapplication.h"
 
-#include <sys/types.h>
-#include<sys/socket.h>
-#include<arpa/inet.h>
-#include<netinet/in.h>
-#include<errno.h>
-#include <unistd.h>
-
-#include"zookeeperutil.h"
-
-// 设置超时
-void Mprpcchannel::Setimeout(int sockfd, int timeoutSec){
-    struct timeval timeout;
-    timeout.tv_sec = timeoutSec;
-    timeout.tv_usec = 0;
-
-    //发送超时
-    setsockopt(sockfd,SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
-    //接收超时
-    setsockopt(sockfd,SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#include "mprpcconnection.h"
+#include "mprpccodec.h"
+#include "mprpccontroller.h"
+#include "loadbalancer.h"
+#include "circuitbreaker.h"
+#include "monitor.h"
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include"servicedirectory.h"
+
+// 未设置截止时间的rpc调用等待响应的默认超时，可在配置文件中设置 rpctimeoutms=5000
+static int DefaultTimeoutMs()
+{
+    static const int timeoutMs = []() {
+        std::string value = MprpcApplication::GetConfig().LoadConfig("rpctimeoutms");
+        return value.empty() ? 5000 : atoi(value.c_str());
+    }();
+    return timeoutMs;
+}
+
+// 同步调用的等待状态，由调用线程和IO线程共享
+struct SyncCall
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;  // 响应已到达、超时或连接失败
+    std::string errText;
+};
+
+// 一个服务节点的熔断器和监控句柄，创建后不再修改
+struct MprpcEndpoint
+{
+    MprpcEndpoint(int failureThreshold, int openMs, ServiceMonitor::MethodId id)
+        : breaker(failureThreshold, openMs), monitorId(id)
+    {
+    }
+    CircuitBreaker breaker;
+    ServiceMonitor::MethodId monitorId;
+};
+
+/*
+    调用方的节点健康状态，进程内所有channel共享
+    每个节点 ip:port 一个熔断器：连续失败(超时、断线、服务端错误)达到阈值后打开，
+    打开期间发往该节点的调用直接失败并改选其他节点，超时后放行少量试探请求。
+    每个节点的调用延迟记录在ServiceMonitor中，以节点作为方法名。
+*/
+class EndpointHealth
+{
+public:
+    static EndpointHealth &GetInstance()
+    {
+        static EndpointHealth health;
+        return health;
+    }
+
+    // 获取节点，不存在时创建熔断器并在监控中注册
+    std::shared_ptr<MprpcEndpoint> GetEndpoint(const std::string &node)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            auto it = _endpoints.find(node);
+            if (it != _endpoints.end())
+            {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        std::shared_ptr<MprpcEndpoint> &endpoint = _endpoints[node];
+        if (endpoint == nullptr)
+        {
+            endpoint = std::make_shared<MprpcEndpoint>(_failureThreshold, _openMs, _monitor.RegisterMethod(node));
+        }
+        return endpoint;
+    }
+
+    // 记录一次调用的结果，不加锁
+    void Record(MprpcEndpoint &endpoint, bool success, std::chrono::steady_clock::time_point start)
+    {
+        if (success)
+        {
+            endpoint.breaker.OnSuccess(start);
+        }
+        else
+        {
+            endpoint.breaker.OnFailure(start);
+        }
+        int64_t latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        _monitor.RecordRequest(endpoint.monitorId, success, latencyMs);
+    }
+
+    ServiceMonitor &Monitor() { return _monitor; }
+
+private:
+    // 熔断参数可在配置文件中设置 rpcbreakerfailures=5 rpcbreakeropenms=5000
+    EndpointHealth() : _failureThreshold(5), _openMs(5000), _monitor("MprpcClient")
+    {
+        std::string value = MprpcApplication::GetConfig().LoadConfig("rpcbreakerfailures");
+        if (!value.empty())
+        {
+            _failureThreshold = atoi(value.c_str());
+        }
+        value = MprpcApplication::GetConfig().LoadConfig("rpcbreakeropenms");
+        if (!value.empty())
+        {
+            _openMs = atoi(value.c_str());
+        }
+    }
+
+    int _failureThreshold;
+    int _openMs;
+    std::shared_mutex _mutex;
+    std::unordered_map<std::string, std::shared_ptr<MprpcEndpoint>> _endpoints;
+    ServiceMonitor _monitor;
+};
+
+// controller可能为空(如网关直接传nullptr)
+static void MarkFailed(google::protobuf::RpcController *controller, const std::string &reason)
+{
+    if (controller != nullptr)
+    {
+        controller->SetFailed(reason);
+    }
+}
+
+static void SetCallFailed(google::protobuf::RpcController *controller, const std::string &reason)
+{
+    LOG_ERROR("%s", reason.c_str());
+    MarkFailed(controller, reason);
+}
+
+// 发送前就失败的调用，异步模式下同样要执行done
+static void FailCall(google::protobuf::RpcController *controller, google::protobuf::Closure *done, const std::string &reason)
+{
+    // 熔断打开时每次调用都在这里快速失败，采样打印
+    LOG_ERROR_EVERY_N(100, "%s", reason.c_str());
+    MarkFailed(controller, reason);
+    if (done != nullptr)
+    {
+        done->Run();
+    }
+}
+
+Mprpcchannel::Mprpcchannel() : _fixedPort(0)
+{
+}
+
+Mprpcchannel::Mprpcchannel(const std::string& ip, uint16_t port) : _fixedIp(ip), _fixedPort(port)
+{
+}
+
+struct Mprpcchannel::Route
+{
+    ServiceDirectory::AddrList addrs;       // 建立均衡器时的节点列表
+    std::shared_ptr<LoadBalancer> balancer; // 节点名为 ip:port
+};
+
+// 设置负载均衡策略
+void Mprpcchannel::SetLoadBalancer(LoadBalancerFactory factory)
+{
+    std::unique_lock<std::shared_mutex> lock(_routeMutex);
+    _balancerFactory = std::move(factory);
+    _routes.clear();
+}
+
+// 获取方法的均衡器
+std::shared_ptr<const Mprpcchannel::Route> Mprpcchannel::GetRoute(const google::protobuf::MethodDescriptor *method,
+                                                                  const ServiceDirectory::AddrList &addrs)
+{
+    LoadBalancerFactory factory;
+    {
+        std::shared_lock<std::shared_mutex> lock(_routeMutex);
+        auto it = _routes.find(method);
+        // 服务目录在节点变化后会换一份新的列表，列表未变时直接复用
+        if (it != _routes.end() && it->second->addrs == addrs)
+        {
+            return it->second;
+        }
+        factory = _balancerFactory;
+    }
+    if (!factory)
+    {
+        return nullptr;
+    }
+
+    // 按当前节点重建均衡器，一致性哈希的节点位置只取决于节点名，未变化的节点上的路由保持不变
+    auto route = std::make_shared<Route>();
+    route->addrs = addrs;
+    route->balancer = factory();
+    if (route->balancer == nullptr)
+    {
+        return nullptr;
+    }
+    for (const ServiceAddr &addr : *addrs)
+    {
+        route->balancer->AddNode(addr.ip + ":" + std::to_string(addr.port));
+    }
+    std::unique_lock<std::shared_mutex> lock(_routeMutex);
+    _routes[method] = route;
+    return route;
+}
+
+// 调用方各节点的调用统计
+ServiceMonitor &Mprpcchannel::GetMonitor()
+{
+    return EndpointHealth::GetInstance().Monitor();
 }
 
 // 设置服务端地址
-bool Mprpcchannel::GetSeverAddr(const std::string& serviceName, const std::string& methodName, std::string& ip, uint16_t& port){
-    
-    //zk
-    ZkClient zkcli;
-    zkcli.Start();
-    // /service_name/method_name
-    std::string methodPath = "/" + serviceName + "/" + methodName;
-    // data: ip:rpc_port
-    std::string hostData = zkcli.GetData(methodPath.c_str());
-    if(hostData == "")
-    {
-        LOG_ERROR("method is not exist");
+bool Mprpcchannel::GetSeverAddr(const google::protobuf::MethodDescriptor *method, google::protobuf::RpcController *controller,
+                                std::string &ip, uint16_t &port, std::shared_ptr<MprpcEndpoint> &endpoint, std::string &errText)
+{
+    // 服务目录缓存了zk上的节点列表，只有首次查询或节点变化后才访问zk
+    ServiceDirectory::AddrList addrs = ServiceDirectory::GetInstance().Lookup(method->service()->name(), method->name());
+    if(addrs == nullptr)
+    {
+        errText = "rpc service not exist";
         return false;
     }
-    int idx = hostData.find(":");
-    if(-1 == idx)
+
+    // 路由键：controller指定时使用(同一用户固定到同一节点)，否则用递增序号在节点间轮转
+    static std::atomic<uint32_t> next(0);
+    int key;
+    MprpcController *mprpcController = dynamic_cast<MprpcController *>(controller);
+    if (mprpcController != nullptr && mprpcController->HasRouteKey())
     {
-        LOG_ERROR(" address is invalid!");
-        return false;
+        key = mprpcController->RouteKey();
+    }
+    else
+    {
+        key = static_cast<int>(next++ & 0x7fffffff);
+    }
+
+    // 首选节点由均衡器给出，未设置均衡器或均衡器没有给出节点时按路由键取模
+    std::string preferred;
+    std::shared_ptr<const Route> route = GetRoute(method, addrs);
+    if (route != nullptr)
+    {
+        preferred = route->balancer->SelectNode(key);
     }
-    ip = hostData.substr(0, idx);
-    port = atoi(hostData.substr(idx+1, hostData.size()-idx).c_str());
-    return true;
+
+    // 熔断的节点不参与均衡：首选节点熔断时按顺序改用其他节点，同一路由键改用的节点也固定
+    EndpointHealth &health = EndpointHealth::GetInstance();
+    size_t count = addrs->size();
+    for (size_t i = 0; i <= count; ++i)
+    {
+        std::string node;
+        if (i == 0)
+        {
+            if (preferred.empty())
+            {
+                continue;
+            }
+            node = preferred;
+        }
+        else
+        {
+            const ServiceAddr &addr = (*addrs)[(static_cast<uint32_t>(key) + i - 1) % count];
+            node = addr.ip + ":" + std::to_string(addr.port);
+            if (node == preferred)
+            {
+                continue;
+            }
+        }
+        size_t idx = node.rfind(':');
+        if (idx == std::string::npos)
+        {
+            LOG_ERROR("load balancer returned invalid node: %s", node.c_str());
+            continue;
+        }
+        endpoint = health.GetEndpoint(node);
+        if (endpoint->breaker.CanPass())
+        {
+            ip = node.substr(0, idx);
+            port = atoi(node.c_str() + idx + 1);
+            return true;
+        }
+    }
+    errText = "rpc service unavailable, all nodes circuit open";
+    return false;
 }
 
 void Mprpcchannel::CallMethod(const google::protobuf::MethodDescriptor *method,
@@ -57,124 +297,144 @@ void Mprpcchannel::CallMethod(const google::protobuf::MethodDescriptor *method,
                               google::protobuf::Closure *done)
 {
     const google::protobuf::ServiceDescriptor *SerDsc = method->service();
-    std::string ServName = SerDsc->name();
-    std::string MethName = method->name();
+    const std::string &ServName = SerDsc->name();
+    const std::string &MethName = method->name();
 
-    // 获取参数的序列化字符串长度 args_size
-    uint32_t args_size = 0;
-    std::string argsStr;
-    //arg
-    if (request->SerializeToString(&argsStr))
+    // 截止时间：controller设置的优先，否则使用默认超时；当前线程正在执行rpc方法时不超过该方法的截止时间
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline = now + std::chrono::milliseconds(DefaultTimeoutMs());
+    MprpcController *mprpcController = dynamic_cast<MprpcController *>(controller);
+    if (mprpcController != nullptr && mprpcController->HasDeadline())
     {
-        args_size = argsStr.size();
+        deadline = mprpcController->Deadline();
     }
-    else
+    std::chrono::steady_clock::time_point inherited;
+    if (MprpcController::CurrentDeadline(inherited) && inherited < deadline)
     {
-        LOG_ERROR("serialize request_str error!");
-        controller->SetFailed("serialize request_str error!");
+        deadline = inherited;
+    }
+    if (deadline <= now)
+    {
+        // 上游已经放弃等待，不再发出请求
+        FailCall(controller, done, "rpc deadline exceeded");
         return;
     }
+    // 向上取整，剩余不足1毫秒时按1毫秒
+    int64_t timeoutMs = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now + std::chrono::microseconds(999)).count();
+    double timeoutSec = timeoutMs / 1000.0;
 
-    //header
-    mprpc::mpRpcHeader mprpcHeader;
-    mprpcHeader.set_service_name(ServName);
-    mprpcHeader.set_method_name(MethName);
-    mprpcHeader.set_args_size(args_size);
-    //headerSize
-    uint32_t headerSize = 0;
-    std::string mprpcHeaderStr;
-    if(mprpcHeader.SerializePartialToString(&mprpcHeaderStr))
+    //在zk中获取服务地址，直连模式使用构造时指定的节点
+    std::string ip = _fixedIp;
+    uint16_t port = _fixedPort;
+    std::shared_ptr<MprpcEndpoint> endpoint;
+    std::string errText;
+    if (ip.empty())
     {
-        headerSize = mprpcHeaderStr.size();
+        if (!GetSeverAddr(method, controller, ip, port, endpoint, errText))
+        {
+            FailCall(controller, done, errText);
+            return;
+        }
     }
     else
     {
-        LOG_ERROR("serialize mprpcHeader error!");
-        controller->SetFailed("serialize mprpcHeader error!");
-        //std::cout << "serialize mprpcHeader error!" << std::endl;
-        return;
-    }
-
-    //组合字符流
-    //（headerSize + header(service/method/argsize) + argStr）
-    std::string sendBuf;
-    sendBuf.insert(0, std::string((char*)&headerSize, 4));
-    sendBuf += mprpcHeaderStr;
-    sendBuf += argsStr;
-
-    // 打印调试信息
-    std::cout << "============================================" << std::endl;
-    std::cout << "header_size: " << headerSize << std::endl; 
-    std::cout << "rpc_header_str: " << mprpcHeaderStr << std::endl; 
-    std::cout << "service_name: " << ServName << std::endl; 
-    std::cout << "method_name: " << MethName << std::endl; 
-    std::cout << "args_str: " << argsStr << std::endl; 
-    std::cout << "============================================" << std::endl;
-
-    //在zk中获取服务地址
-    std::string ip;
-    uint16_t port;
-    if(!GetSeverAddr(ServName, MethName, ip, port)){
-        controller->SetFailed("rpc service not exist");
-        return;
+        endpoint = EndpointHealth::GetInstance().GetEndpoint(ip + ":" + std::to_string(port));
+        if (!endpoint->breaker.CanPass())
+        {
+            FailCall(controller, done, "rpc endpoint circuit open");
+            return;
+        }
     }
+    std::shared_ptr<MprpcConnection> conn = MprpcConnectionPool::GetInstance().GetConnection(ip, port);
 
-    //tcp
-    int clientfd = socket(AF_INET, SOCK_STREAM, 0);
-    if( -1 == clientfd)
+    //header
+    // 方法id由描述符计算一次后缓存；该连接上的服务端确认过此id后，请求只带id不带服务名和方法名
+    thread_local std::unordered_map<const google::protobuf::MethodDescriptor *, uint32_t> methodIds;
+    uint32_t &methodId = methodIds[method];
+    if (methodId == 0)
     {
-        std::cout << "create socket error!" << std::endl;
-        controller->SetFailed("create socket error");
-        return;
-        //exit(EXIT_FAILURE);
-    }
-
-    // 读取配置文件rpcserver的信息
-    //std::string ip = MprpcApplication::GetConfig().LoadConfig("rpcserverip");
-    //uint16_t port = atoi(MprpcApplication::GetConfig().LoadConfig("rpcserverport").c_str());
-    // 建立连接超时
-    Setimeout(clientfd, 5);
-   
-
-    struct sockaddr_in server_addr;
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
-    server_addr.sin_addr.s_addr= inet_addr(ip.c_str());
-
-    // 连接rpc服务节点
-    if(-1 == connect(clientfd, (struct sockaddr*)&server_addr, sizeof(server_addr)))
-    {   
-        close(clientfd);
-        std::cout << "connect error!" << std::endl;
-        controller->SetFailed("connect error!");
-        return;
+        methodId = MprpcCodec::MethodId(method);
     }
-    // 发送rpc请求
-    if(-1 == send(clientfd, sendBuf.c_str(), sendBuf.size(), 0))
+    mprpc::mpRpcHeader mprpcHeader;
+    mprpcHeader.set_method_id(methodId);
+    if (!conn->MethodIdConfirmed(methodId))
     {
-        close(clientfd);
-        std::cout << "send error!" << std::endl;
-        controller->SetFailed("send error!");
-        return;
+        mprpcHeader.set_service_name(ServName);
+        mprpcHeader.set_method_name(MethName);
     }
+    uint64_t requestId = MprpcConnectionPool::GetInstance().NextRequestId();
+    mprpcHeader.set_request_id(requestId);
+    mprpcHeader.set_timeout_ms(static_cast<uint32_t>(std::min<int64_t>(timeoutMs, UINT32_MAX)));
 
-    // 接收rpc请求的响应值
-    char recvBuf[1024]={0};
-    int recvSize = 0;
-    if(-1 == (recvSize = recv(clientfd, recvBuf, 1024, 0)))
+    //组合字符流，header和参数直接序列化进发送缓冲区
+    //（frameLen + headerLen + header(method_id/argsize) + arg）
+    std::string sendBuf;
+    if (!MprpcCodec::Encode(mprpcHeader, request, &sendBuf))
     {
-        close(clientfd);
-        std::cout << "receive error!" << std::endl;
+        // 请求没有发往节点，不计入熔断结果，但要归还CanPass占用的试探名额
+        endpoint->breaker.Release();
+        FailCall(controller, done, "serialize request_str error!");
         return;
     }
 
-    //// 反序列化rpc调用的响应数据
-    if(!response->ParseFromArray(recvBuf, recvSize))
+    LOG_DEBUG("request_id:%lu method:%s.%s frame_size:%lu args_size:%u", static_cast<unsigned long>(requestId),
+              ServName.c_str(), MethName.c_str(), static_cast<unsigned long>(sendBuf.size()), mprpcHeader.args_size());
+
+    // 复用到该节点的长连接，响应按request_id匹配
+
+    if (done != nullptr)
     {
-        close(clientfd);
-        std::cout << "parse error!" << std::endl;
+        // 异步调用：立即返回，响应在IO线程直接从接收缓冲区反序列化到response，
+        // 之后把done投递回发起调用的EventLoop执行；调用方不在EventLoop线程时在IO线程执行done
+        muduo::net::EventLoop *callerLoop = muduo::net::EventLoop::getEventLoopOfCurrentThread();
+        auto start = std::chrono::steady_clock::now();
+        conn->Send(requestId, std::move(sendBuf), [controller, response, done, callerLoop, endpoint, start](const std::string &errText, const char *data, size_t len) {
+            std::string reason = errText;
+            if (reason.empty() && !response->ParseFromArray(data, static_cast<int>(len)))
+            {
+                reason = "parse error!";
+            }
+            EndpointHealth::GetInstance().Record(*endpoint, reason.empty(), start);
+            if (!reason.empty())
+            {
+                SetCallFailed(controller, reason);
+            }
+            if (callerLoop != nullptr)
+            {
+                callerLoop->queueInLoop([done]() { done->Run(); });
+            }
+            else
+            {
+                done->Run();
+            }
+        }, timeoutSec);
         return;
     }
 
-    close(clientfd);
-}
\ No newline at end of file
+    // 同步调用：阻塞等待，超时由连接负责回调
+    auto call = std::make_shared<SyncCall>();
+    auto start = std::chrono::steady_clock::now();
+    conn->Send(requestId, std::move(sendBuf), [call, response, endpoint, start](const std::string &errText, const char *data, size_t len) {
+        std::lock_guard<std::mutex> lock(call->mutex);
+        //// 反序列化rpc调用的响应数据
+        if (errText.empty() && !response->ParseFromArray(data, static_cast<int>(len)))
+        {
+            call->errText = "parse error!";
+        }
+        else
+        {
+            call->errText = errText;
+        }
+        EndpointHealth::GetInstance().Record(*endpoint, call->errText.empty(), start);
+        call->finished = true;
+        call->cv.notify_one();
+    }, timeoutSec);
+
+    // 等待响应
+    std::unique_lock<std::mutex> lock(call->mutex);
+    call->cv.wait(lock, [&call]() { return call->finished; });
+    if (!call->errText.empty())
+    {
+        SetCallFailed(controller, call->errText);
+    }
+}
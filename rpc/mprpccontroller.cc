@@ -1,14 +1,24 @@
 #include "mprpccontroller.h"
 
+// 当前线程正在执行的rpc方法的截止时间
+static thread_local bool t_hasDeadline = false;
+static thread_local std::chrono::steady_clock::time_point t_deadline;
+
 MprpcController::MprpcController()
 {
     m_failed = false;
     m_errText = "";
+    m_hasRouteKey = false;
+    m_routeKey = 0;
+    m_hasDeadline = false;
 }
 void MprpcController::Reset()
 {
     m_failed = false;
     m_errText = "";
+    m_hasRouteKey = false;
+    m_routeKey = 0;
+    m_hasDeadline = false;
 }
 bool MprpcController::Failed() const
 {
@@ -25,6 +35,58 @@ void MprpcController::SetFailed(const std::string &reason)
     
 };
 
+void MprpcController::SetRouteKey(int key)
+{
+    m_hasRouteKey = true;
+    m_routeKey = key;
+}
+bool MprpcController::HasRouteKey() const
+{
+    return m_hasRouteKey;
+}
+int MprpcController::RouteKey() const
+{
+    return m_routeKey;
+}
+void MprpcController::SetTimeout(int timeoutMs)
+{
+    SetDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs));
+}
+void MprpcController::SetDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    m_hasDeadline = true;
+    m_deadline = deadline;
+}
+bool MprpcController::HasDeadline() const
+{
+    return m_hasDeadline;
+}
+std::chrono::steady_clock::time_point MprpcController::Deadline() const
+{
+    return m_deadline;
+}
+bool MprpcController::CurrentDeadline(std::chrono::steady_clock::time_point &deadline)
+{
+    if (!t_hasDeadline)
+    {
+        return false;
+    }
+    deadline = t_deadline;
+    return true;
+}
+
+MprpcDeadlineScope::MprpcDeadlineScope(bool hasDeadline, std::chrono::steady_clock::time_point deadline)
+    : m_prevHasDeadline(t_hasDeadline), m_prevDeadline(t_deadline)
+{
+    t_hasDeadline = hasDeadline;
+    t_deadline = deadline;
+}
+MprpcDeadlineScope::~MprpcDeadlineScope()
+{
+    t_hasDeadline = m_prevHasDeadline;
+    t_deadline = m_prevDeadline;
+}
+
 // 未具体实现
 void MprpcController::StartCancel() {}
 bool MprpcController::IsCanceled() const { return false; }
@@ -0,0 +1,227 @@
+#include "mprpcexecutor.h"
+
+MprpcExecutor::MprpcExecutor() : _pending(0), _running(false)
+{
+}
+
+MprpcExecutor::~MprpcExecutor()
+{
+    Stop();
+}
+
+// 注册方法
+int MprpcExecutor::RegisterMethod(const std::string &name)
+{
+    std::unique_ptr<Method> method(new Method);
+    method->name = name;
+    _methods.push_back(std::move(method));
+    return static_cast<int>(_methods.size()) - 1;
+}
+
+// 单独设置某个方法的并发上限
+void MprpcExecutor::SetMethodLimit(int methodId, int limit)
+{
+    _methods[methodId]->limit = limit;
+}
+
+// 按配置启动工作线程
+void MprpcExecutor::Start(const MprpcExecutorOptions &options)
+{
+    _options = options;
+    for (auto &method : _methods)
+    {
+        if (method->limit == 0)
+        {
+            method->limit = options.maxConcurrencyPerMethod;
+        }
+    }
+    _running = true;
+    for (int i = 0; i < options.threadNum; ++i)
+    {
+        _workers.emplace_back(&MprpcExecutor::WorkerLoop, this);
+    }
+}
+
+// 停止工作线程
+void MprpcExecutor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running)
+        {
+            return;
+        }
+        _running = false;
+    }
+    _cond.notify_all();
+    for (std::thread &worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+// 提交请求
+bool MprpcExecutor::Submit(int methodId, uint64_t connKey, Task task)
+{
+    Method &method = *_methods[methodId];
+    if (_workers.empty())
+    {
+        // 未启用工作线程，直接在IO线程执行
+        Clock::time_point start = Clock::now();
+        task();
+        uint64_t execUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        ++method.calls;
+        method.execUs += execUs;
+        UpdateMax(method.maxExecUs, execUs);
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending >= _options.maxQueueSize)
+    {
+        ++method.rejected;
+        return false;
+    }
+    ++_pending;
+    Item item{methodId, connKey, std::move(task), Clock::now()};
+    if (_options.orderedPerConnection)
+    {
+        auto it = _strands.find(connKey);
+        if (it != _strands.end())
+        {
+            // 该连接已有请求在处理，排在其后
+            it->second.push_back(std::move(item));
+            return true;
+        }
+        _strands.emplace(connKey, std::deque<Item>());
+    }
+    Admit(std::move(item));
+    return true;
+}
+
+// 方法并发检查
+void MprpcExecutor::Admit(Item item)
+{
+    Method &method = *_methods[item.methodId];
+    if (method.limit > 0 && method.running >= method.limit)
+    {
+        method.waiting.push_back(std::move(item));
+        return;
+    }
+    ++method.running;
+    _ready.push_back(std::move(item));
+    _cond.notify_one();
+}
+
+// 请求执行完毕
+void MprpcExecutor::Finish(const Item &item)
+{
+    Method &method = *_methods[item.methodId];
+    --method.running;
+    if (!method.waiting.empty())
+    {
+        Item next = std::move(method.waiting.front());
+        method.waiting.pop_front();
+        ++method.running;
+        _ready.push_back(std::move(next));
+        _cond.notify_one();
+    }
+
+    if (_options.orderedPerConnection)
+    {
+        auto it = _strands.find(item.connKey);
+        if (it == _strands.end())
+        {
+            return;
+        }
+        if (it->second.empty())
+        {
+            _strands.erase(it);
+            return;
+        }
+        // 放行该连接的下一个请求
+        Item next = std::move(it->second.front());
+        it->second.pop_front();
+        Admit(std::move(next));
+    }
+}
+
+// 工作线程
+void MprpcExecutor::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _cond.wait(lock, [this]() { return !_ready.empty() || !_running; });
+        if (!_running)
+        {
+            break;
+        }
+        Item item = std::move(_ready.front());
+        _ready.pop_front();
+        --_pending;
+        lock.unlock();
+
+        Method &method = *_methods[item.methodId];
+        Clock::time_point start = Clock::now();
+        uint64_t waitUs = std::chrono::duration_cast<std::chrono::microseconds>(start - item.enqueueTime).count();
+        item.task();
+        item.task = nullptr;
+        uint64_t execUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+        ++method.calls;
+        method.queueWaitUs += waitUs;
+        UpdateMax(method.maxQueueWaitUs, waitUs);
+        method.execUs += execUs;
+        UpdateMax(method.maxExecUs, execUs);
+
+        lock.lock();
+        Finish(item);
+    }
+}
+
+// 当前排队的请求数
+size_t MprpcExecutor::QueueSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending;
+}
+
+// 各方法统计
+std::vector<MprpcExecutor::MethodStats> MprpcExecutor::GetMethodStats() const
+{
+    std::vector<MethodStats> result;
+    for (const auto &method : _methods)
+    {
+        result.push_back(MethodStats{method->name, method->calls, method->rejected,
+                                     method->queueWaitUs, method->maxQueueWaitUs,
+                                     method->execUs, method->maxExecUs});
+    }
+    return result;
+}
+
+// 输出统计
+void MprpcExecutor::GetStats(std::map<std::string, std::string> &stats) const
+{
+    stats["executor_queue_size"] = std::to_string(QueueSize());
+    for (const MethodStats &method : GetMethodStats())
+    {
+        std::string prefix = "method_" + method.name + "_";
+        stats[prefix + "calls"] = std::to_string(method.calls);
+        stats[prefix + "rejected"] = std::to_string(method.rejected);
+        stats[prefix + "avg_queue_wait_us"] = std::to_string(method.calls ? method.queueWaitUs / method.calls : 0);
+        stats[prefix + "max_queue_wait_us"] = std::to_string(method.maxQueueWaitUs);
+        stats[prefix + "avg_exec_us"] = std::to_string(method.calls ? method.execUs / method.calls : 0);
+        stats[prefix + "max_exec_us"] = std::to_string(method.maxExecUs);
+    }
+}
+
+// 更新最大值
+void MprpcExecutor::UpdateMax(std::atomic<uint64_t> &target, uint64_t value)
+{
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
@@ -25,7 +25,12 @@ PROTOBUF_CONSTEXPR mpRpcHeader::mpRpcHeader(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.service_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.method_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.error_text_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.request_id_)*/uint64_t{0u}
   , /*decltype(_impl_.args_size_)*/0u
+  , /*decltype(_impl_.error_code_)*/0
+  , /*decltype(_impl_.method_id_)*/0u
+  , /*decltype(_impl_.timeout_ms_)*/0u
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct mpRpcHeaderDefaultTypeInternal {
   PROTOBUF_CONSTEXPR mpRpcHeaderDefaultTypeInternal()
@@ -51,6 +56,11 @@ const uint32_t TableStruct_mprpcheader_2eproto::offsets[] PROTOBUF_SECTION_VARIA
   PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.service_name_),
   PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.method_name_),
   PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.args_size_),
+  PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.request_id_),
+  PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.error_code_),
+  PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.error_text_),
+  PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.method_id_),
+  PROTOBUF_FIELD_OFFSET(::mprpc::mpRpcHeader, _impl_.timeout_ms_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::mprpc::mpRpcHeader)},
@@ -61,13 +71,16 @@ static const ::_pb::Message* const file_default_instances[] = {
 };
 
 const char descriptor_table_protodef_mprpcheader_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\021mprpcheader.proto\022\005mprpc\"K\n\013mpRpcHeade"
-  "r\022\024\n\014service_name\030\001 \001(\014\022\023\n\013method_name\030\002"
-  " \001(\014\022\021\n\targs_size\030\003 \001(\rb\006proto3"
+  "\n\021mprpcheader.proto\022\005mprpc\"\256\001\n\013mpRpcHead"
+  "er\022\024\n\014service_name\030\001 \001(\014\022\023\n\013method_name\030"
+  "\002 \001(\014\022\021\n\targs_size\030\003 \001(\r\022\022\n\nrequest_id\030\004"
+  " \001(\004\022\022\n\nerror_code\030\005 \001(\005\022\022\n\nerror_text\030\006"
+  " \001(\014\022\021\n\tmethod_id\030\007 \001(\007\022\022\n\ntimeout_ms\030\010 "
+  "\001(\rb\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_mprpcheader_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_mprpcheader_2eproto = {
-    false, false, 111, descriptor_table_protodef_mprpcheader_2eproto,
+    false, false, 211, descriptor_table_protodef_mprpcheader_2eproto,
     "mprpcheader.proto",
     &descriptor_table_mprpcheader_2eproto_once, nullptr, 0, 1,
     schemas, file_default_instances, TableStruct_mprpcheader_2eproto::offsets,
@@ -100,7 +113,12 @@ mpRpcHeader::mpRpcHeader(const mpRpcHeader& from)
   new (&_impl_) Impl_{
       decltype(_impl_.service_name_){}
     , decltype(_impl_.method_name_){}
+    , decltype(_impl_.error_text_){}
+    , decltype(_impl_.request_id_){}
     , decltype(_impl_.args_size_){}
+    , decltype(_impl_.error_code_){}
+    , decltype(_impl_.method_id_){}
+    , decltype(_impl_.timeout_ms_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -120,7 +138,17 @@ mpRpcHeader::mpRpcHeader(const mpRpcHeader& from)
     _this->_impl_.method_name_.Set(from._internal_method_name(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.args_size_ = from._impl_.args_size_;
+  _impl_.error_text_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_text_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_error_text().empty()) {
+    _this->_impl_.error_text_.Set(from._internal_error_text(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.request_id_, &from._impl_.request_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.timeout_ms_) -
+    reinterpret_cast<char*>(&_impl_.request_id_)) + sizeof(_impl_.timeout_ms_));
   // @@protoc_insertion_point(copy_constructor:mprpc.mpRpcHeader)
 }
 
@@ -131,7 +159,12 @@ inline void mpRpcHeader::SharedCtor(
   new (&_impl_) Impl_{
       decltype(_impl_.service_name_){}
     , decltype(_impl_.method_name_){}
+    , decltype(_impl_.error_text_){}
+    , decltype(_impl_.request_id_){uint64_t{0u}}
     , decltype(_impl_.args_size_){0u}
+    , decltype(_impl_.error_code_){0}
+    , decltype(_impl_.method_id_){0u}
+    , decltype(_impl_.timeout_ms_){0u}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.service_name_.InitDefault();
@@ -142,6 +175,10 @@ inline void mpRpcHeader::SharedCtor(
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
     _impl_.method_name_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.error_text_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_text_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 mpRpcHeader::~mpRpcHeader() {
@@ -157,6 +194,7 @@ inline void mpRpcHeader::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
   _impl_.service_name_.Destroy();
   _impl_.method_name_.Destroy();
+  _impl_.error_text_.Destroy();
 }
 
 void mpRpcHeader::SetCachedSize(int size) const {
@@ -171,7 +209,10 @@ void mpRpcHeader::Clear() {
 
   _impl_.service_name_.ClearToEmpty();
   _impl_.method_name_.ClearToEmpty();
-  _impl_.args_size_ = 0u;
+  _impl_.error_text_.ClearToEmpty();
+  ::memset(&_impl_.request_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.timeout_ms_) -
+      reinterpret_cast<char*>(&_impl_.request_id_)) + sizeof(_impl_.timeout_ms_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -207,6 +248,47 @@ const char* mpRpcHeader::_InternalParse(const char* ptr, ::_pbi::ParseContext* c
         } else
           goto handle_unusual;
         continue;
+      // uint64 request_id = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.request_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 error_code = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.error_code_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes error_text = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          auto str = _internal_mutable_error_text();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed32 method_id = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 61)) {
+          _impl_.method_id_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint32_t>(ptr);
+          ptr += sizeof(uint32_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 timeout_ms = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _impl_.timeout_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -254,6 +336,36 @@ uint8_t* mpRpcHeader::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteUInt32ToArray(3, this->_internal_args_size(), target);
   }
 
+  // uint64 request_id = 4;
+  if (this->_internal_request_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_request_id(), target);
+  }
+
+  // int32 error_code = 5;
+  if (this->_internal_error_code() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(5, this->_internal_error_code(), target);
+  }
+
+  // bytes error_text = 6;
+  if (!this->_internal_error_text().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        6, this->_internal_error_text(), target);
+  }
+
+  // fixed32 method_id = 7;
+  if (this->_internal_method_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed32ToArray(7, this->_internal_method_id(), target);
+  }
+
+  // uint32 timeout_ms = 8;
+  if (this->_internal_timeout_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(8, this->_internal_timeout_ms(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -284,11 +396,38 @@ size_t mpRpcHeader::ByteSizeLong() const {
         this->_internal_method_name());
   }
 
+  // bytes error_text = 6;
+  if (!this->_internal_error_text().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_error_text());
+  }
+
+  // uint64 request_id = 4;
+  if (this->_internal_request_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_request_id());
+  }
+
   // uint32 args_size = 3;
   if (this->_internal_args_size() != 0) {
     total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_args_size());
   }
 
+  // int32 error_code = 5;
+  if (this->_internal_error_code() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_error_code());
+  }
+
+  // fixed32 method_id = 7;
+  if (this->_internal_method_id() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // uint32 timeout_ms = 8;
+  if (this->_internal_timeout_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_timeout_ms());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -313,9 +452,24 @@ void mpRpcHeader::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PR
   if (!from._internal_method_name().empty()) {
     _this->_internal_set_method_name(from._internal_method_name());
   }
+  if (!from._internal_error_text().empty()) {
+    _this->_internal_set_error_text(from._internal_error_text());
+  }
+  if (from._internal_request_id() != 0) {
+    _this->_internal_set_request_id(from._internal_request_id());
+  }
   if (from._internal_args_size() != 0) {
     _this->_internal_set_args_size(from._internal_args_size());
   }
+  if (from._internal_error_code() != 0) {
+    _this->_internal_set_error_code(from._internal_error_code());
+  }
+  if (from._internal_method_id() != 0) {
+    _this->_internal_set_method_id(from._internal_method_id());
+  }
+  if (from._internal_timeout_ms() != 0) {
+    _this->_internal_set_timeout_ms(from._internal_timeout_ms());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -343,7 +497,16 @@ void mpRpcHeader::InternalSwap(mpRpcHeader* other) {
       &_impl_.method_name_, lhs_arena,
       &other->_impl_.method_name_, rhs_arena
   );
-  swap(_impl_.args_size_, other->_impl_.args_size_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.error_text_, lhs_arena,
+      &other->_impl_.error_text_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(mpRpcHeader, _impl_.timeout_ms_)
+      + sizeof(mpRpcHeader::_impl_.timeout_ms_)
+      - PROTOBUF_FIELD_OFFSET(mpRpcHeader, _impl_.request_id_)>(
+          reinterpret_cast<char*>(&_impl_.request_id_),
+          reinterpret_cast<char*>(&other->_impl_.request_id_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata mpRpcHeader::GetMetadata() const {
@@ -1,5 +1,24 @@
 #include "mprpcprovider.h"
 #include "mprpcapplication.h"
+#include "mprpccodec.h"
+#include "monitor.h"
+#include "mprpccontroller.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// 过载时逐个请求的拒绝日志每kOverloadLogSample次写一次
+static const unsigned int kOverloadLogSample = 1000;
+
+MprpcProvider::MprpcProvider() : _monitor(new ServiceMonitor("MprpcProvider"))
+{
+}
+
+MprpcProvider::~MprpcProvider()
+{
+    // 先停止工作线程，再析构其使用的arena池和监控
+    _executor.Stop();
+}
 
 // 开启节点 提供RPC服务
 void MprpcProvider::StartMprpc()
@@ -16,6 +35,33 @@ void MprpcProvider::StartMprpc()
     // 设置muduo库的线程数量
     server.setThreadNum(4);
 
+    // 启动方法执行器，之后才开始接收请求
+    if (!_executorConfigured)
+    {
+        LoadExecutorOptions();
+    }
+    _executor.Start(_executorOptions);
+    if (_executor.Enabled())
+    {
+        LOG_INFO("rpc executor threads:%d queue:%lu method_limit:%d ordered:%d",
+                 _executorOptions.threadNum, static_cast<unsigned long>(_executorOptions.maxQueueSize),
+                 _executorOptions.maxConcurrencyPerMethod, _executorOptions.orderedPerConnection ? 1 : 0);
+        // 定期输出各方法的排队等待和执行时间
+        _event_loop.runEvery(60.0, [this]() {
+            for (const MprpcExecutor::MethodStats &stats : _executor.GetMethodStats())
+            {
+                if (stats.calls == 0 && stats.rejected == 0)
+                {
+                    continue;
+                }
+                LOG_INFO("%s calls:%lu rejected:%lu queue_wait_avg_us:%lu queue_wait_max_us:%lu exec_avg_us:%lu exec_max_us:%lu",
+                         stats.name.c_str(), (unsigned long)stats.calls, (unsigned long)stats.rejected,
+                         (unsigned long)(stats.calls ? stats.queueWaitUs / stats.calls : 0), (unsigned long)stats.maxQueueWaitUs,
+                         (unsigned long)(stats.calls ? stats.execUs / stats.calls : 0), (unsigned long)stats.maxExecUs);
+            }
+        });
+    }
+
     // 启动网络服务
     server.start();
 
@@ -24,7 +70,11 @@ void MprpcProvider::StartMprpc()
     ZkClient zkcli;
     zkcli.Start();
 
-     // service_name为永久性节点    method_name为临时性节点
+     // service_name、method_name为永久性节点，每个rpc节点在method_name下注册一个临时子节点 ip:port
+     // 多个节点可以提供同一方法，调用方读取子节点列表
+    char hostData[128] ={0};
+    // data—》rpc_ip:rpc_port
+    sprintf(hostData, "%s:%d", ip.c_str(), port);
     for (auto &sp : _serviceInfo)
     {
         std::string servicePath = "/" + sp.first;
@@ -34,10 +84,10 @@ void MprpcProvider::StartMprpc()
         {
             // /service_name/method_name
             std::string methodPath = servicePath + "/" + mp.first;
-            char methodPath_data[128] ={0};
-            // data—》rpc_ip:rpc_port
-            sprintf(methodPath_data, "%s:%d", ip.c_str(), port);
-            zkcli.Create(methodPath.c_str(), methodPath_data, strlen(methodPath_data), ZOO_EPHEMERAL);
+            zkcli.Create(methodPath.c_str(), nullptr, 0);
+            // /service_name/method_name/rpc_ip:rpc_port
+            std::string hostPath = methodPath + "/" + hostData;
+            zkcli.Create(hostPath.c_str(), hostData, strlen(hostData), ZOO_EPHEMERAL);
         }
     }
 
@@ -45,6 +95,58 @@ void MprpcProvider::StartMprpc()
     _event_loop.loop();
 }
 
+// 设置方法执行器
+void MprpcProvider::SetExecutorOptions(const MprpcExecutorOptions &options)
+{
+    _executorOptions = options;
+    _executorConfigured = true;
+}
+
+// 单独设置某个方法的并发上限
+void MprpcProvider::SetMethodConcurrency(const std::string &serviceName, const std::string &methodName, int limit)
+{
+    auto it = _serviceInfo.find(serviceName);
+    if (it == _serviceInfo.end())
+    {
+        LOG_ERROR("%s is not exist!", serviceName.c_str());
+        return;
+    }
+    auto methit = it->second._methodInfoMap.find(methodName);
+    if (methit == it->second._methodInfoMap.end())
+    {
+        LOG_ERROR("%s is not exist!", methodName.c_str());
+        return;
+    }
+    _executor.SetMethodLimit(methit->second._executorId, limit);
+}
+
+// 从配置文件读取执行器配置，未配置的项保持默认值
+// rpcworkerthreads=8  rpcqueuesize=10000  rpcmethodconcurrency=4  rpcordered=1
+void MprpcProvider::LoadExecutorOptions()
+{
+    MprpcConfig &config = MprpcApplication::GetConfig();
+    std::string value = config.LoadConfig("rpcworkerthreads");
+    if (!value.empty())
+    {
+        _executorOptions.threadNum = atoi(value.c_str());
+    }
+    value = config.LoadConfig("rpcqueuesize");
+    if (!value.empty())
+    {
+        _executorOptions.maxQueueSize = strtoul(value.c_str(), nullptr, 10);
+    }
+    value = config.LoadConfig("rpcmethodconcurrency");
+    if (!value.empty())
+    {
+        _executorOptions.maxConcurrencyPerMethod = atoi(value.c_str());
+    }
+    value = config.LoadConfig("rpcordered");
+    if (!value.empty())
+    {
+        _executorOptions.orderedPerConnection = atoi(value.c_str()) != 0;
+    }
+}
+
 // 连接回调
 void MprpcProvider::OnConnection(const muduo::net::TcpConnectionPtr &conn)
 {
@@ -55,111 +157,241 @@ void MprpcProvider::OnConnection(const muduo::net::TcpConnectionPtr &conn)
     }
 }
 
-// 读写回调 （headerSize + header + arg）
-void MprpcProvider::OnMessage(const muduo::net::TcpConnectionPtr &conn,
-                              muduo::net::Buffer *buffer,
-                              muduo::Timestamp)
+/*
+    一次rpc调用，本身即方法的完成回调(done)
+    对象与request、response分配在同一个arena上：Run发出响应后归还arena，三者一次性析构，
+    不再逐个new/delete。
+    请求带有截止时间时，开始执行前已到期的请求不再执行，调用方此时已放弃等待。
+*/
+class MprpcProvider::RpcCall : public google::protobuf::Closure
 {
-    // 接受RPC请求的字符流
-    std::string recvBuf = buffer->retrieveAllAsString();
+public:
+    RpcCall(MprpcProvider *provider, MprpcCallArena *arena, const muduo::net::TcpConnectionPtr &conn,
+            const MethodInfo *info, google::protobuf::Message *request, uint64_t requestId, uint32_t methodId,
+            uint32_t timeoutMs)
+        : _provider(provider), _arena(arena), _conn(conn), _info(info),
+          _request(request), _response(nullptr), _requestId(requestId), _methodId(methodId),
+          _start(std::chrono::steady_clock::now()), _hasDeadline(timeoutMs != 0),
+          _deadline(_start + std::chrono::milliseconds(timeoutMs))
+    {
+    }
 
-    //检查数据长度
-    if(recvBuf.size() < 4){
-        LOG_ERROR("recvBuf size is too small");
-        return;
+    // 在执行器中调用方法
+    void Execute()
+    {
+        if (_hasDeadline && std::chrono::steady_clock::now() >= _deadline)
+        {
+            // 排队期间已到期，不再执行方法，避免在过载时继续堆积无用的数据库操作
+            LOG_ERROR_EVERY_N(kOverloadLogSample, "deadline exceeded in queue, drop %s", _info->_name.c_str());
+            _provider->SendErrorResponse(_conn, _requestId, kDeadlineExceeded, "deadline exceeded");
+            Finish(false);
+            return;
+        }
+
+        //生成response和controller，与request同在调用arena上
+        _response = _info->_service->GetResponsePrototype(_info->_descriptor).New(_arena->Get());
+        MprpcController *controller = google::protobuf::Arena::Create<MprpcController>(_arena->Get());
+        if (_hasDeadline)
+        {
+            controller->SetDeadline(_deadline);
+        }
+        // 方法执行期间同步发起的下游调用继承本次调用的截止时间
+        MprpcDeadlineScope scope(_hasDeadline, _deadline);
+        //根据远端请求字符流，将请求分配到该节点上发布的相应方法，方法同步完成时返回前本对象已析构
+        _info->_service->CallMethod(_info->_descriptor, controller, _request, _response, this);
+    }
+
+    // 方法完成，发送响应
+    void Run() override
+    {
+        Finish(_provider->SendmprpcResponse(_conn, _response, _requestId, _methodId));
     }
 
-    // headerSize
-    //知服务和方法名字符长度
-    uint32_t headerSize = 0;
-    recvBuf.copy((char *)&headerSize, 4, 0);
+private:
+    // 记录调用统计并归还arena，本对象随arena一起析构，之后不能再访问成员
+    void Finish(bool success)
+    {
+        int64_t latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _start).count();
+        _provider->_monitor->RecordRequest(_info->_monitorId, success, latencyMs);
+        MprpcArenaPool &pool = _provider->_arenaPool;
+        MprpcCallArena *arena = _arena;
+        pool.Release(arena);
+    }
 
-    // header
-    std::string mprpc_headerStr = recvBuf.substr(4, headerSize);
-    std::string ServName;
-    std::string MethName;
-    uint32_t args_size;
+    MprpcProvider *_provider;
+    MprpcCallArena *_arena;
+    muduo::net::TcpConnectionPtr _conn;
+    const MethodInfo *_info;
+    google::protobuf::Message *_request;
+    google::protobuf::Message *_response;
+    uint64_t _requestId;
+    uint32_t _methodId; // 非0时在响应中带回
+    std::chrono::steady_clock::time_point _start; // 收到请求的时间，统计延迟包含排队时间
+    bool _hasDeadline;
+    std::chrono::steady_clock::time_point _deadline; // 收到请求的时间加上调用方剩余的等待时间
+};
 
-    if(!Paresrpcheader(mprpc_headerStr, ServName,MethName, args_size)){
-        LOG_ERROR("Paresrpcheader error");
-        return;
+// 读写回调 （frameLen + headerLen + header + arg）
+// 连接是长连接，客户端可以连续发送多个请求，这里解出缓冲区中所有完整的请求，参数直接在接收缓冲区上反序列化
+void MprpcProvider::OnMessage(const muduo::net::TcpConnectionPtr &conn,
+                              muduo::net::Buffer *buffer,
+                              muduo::Timestamp)
+{
+    mprpc::mpRpcHeader header;
+    const char *args = nullptr;
+    size_t argsSize = 0;
+    size_t frameSize = 0;
+    MprpcCodec::DecodeResult result;
+    while ((result = MprpcCodec::Decode(buffer, &header, &args, &argsSize, &frameSize)) == MprpcCodec::kFrameOk)
+    {
+        HandleRequest(conn, header, args, argsSize);
+        buffer->retrieve(frameSize);
     }
-    
-    //arg
-    std::string argsStr = recvBuf.substr(4 + headerSize, args_size);
-
-    // 打印调试信息
-    LOG_INFO("============================================");
-    LOG_INFO("header_size: %d", headerSize);
-    LOG_INFO("rpc_header_str: %s", mprpc_headerStr.c_str());
-    LOG_INFO("service_name: %s", ServName.c_str());
-    LOG_INFO("method_name: %s", MethName.c_str());
-    LOG_INFO("args_str: %s", argsStr.c_str());
-    LOG_INFO("============================================");
-
-    // 查找请求服务及对象
-    auto it = _serviceInfo.find(ServName);
-    if (it == _serviceInfo.end())
-    {   
-        LOG_ERROR("%s is not exist!", ServName.c_str());
-        return;
+    if (result == MprpcCodec::kFrameError)
+    {
+        // 帧格式错误无法再定位下一帧，断开连接
+        buffer->retrieveAll();
+        conn->shutdown();
     }
-    auto methit = it->second._methodInfoMap.find(MethName);
-    if (methit == it->second._methodInfoMap.end())
+}
+
+// 处理一个完整的rpc请求
+void MprpcProvider::HandleRequest(const muduo::net::TcpConnectionPtr &conn,
+                                  const mprpc::mpRpcHeader &header,
+                                  const char *args,
+                                  size_t argsSize)
+{
+    uint64_t requestId = header.request_id();
+
+    // 优先按方法id查分发表，不做字符串哈希；找不到时按服务名和方法名查找
+    const MethodInfo *info = nullptr;
+    uint32_t echoMethodId = 0; // 按id分发成功时在响应中带回，调用方据此省略名字
+    if (header.method_id() != 0)
     {
-        LOG_ERROR("%s is not exist!", MethName.c_str());
-        return;
+        info = FindMethod(header.method_id());
+        if (info != nullptr && !header.method_name().empty() &&
+            (info->_descriptor->name() != header.method_name() || info->_descriptor->service()->name() != header.service_name()))
+        {
+            // id与名字不一致，以名字为准
+            info = nullptr;
+        }
+        if (info != nullptr)
+        {
+            echoMethodId = header.method_id();
+        }
+        else if (header.service_name().empty())
+        {
+            LOG_ERROR("method id %u is not exist!", header.method_id());
+            SendErrorResponse(conn, requestId, kUnknownMethodId, "unknown method id", header.method_id());
+            return;
+        }
+    }
+    if (info == nullptr)
+    {
+        const std::string &ServName = header.service_name();
+        const std::string &MethName = header.method_name();
+        // 查找请求服务及对象
+        auto it = _serviceInfo.find(ServName);
+        if (it == _serviceInfo.end())
+        {   
+            LOG_ERROR("%s is not exist!", ServName.c_str());
+            SendErrorResponse(conn, requestId, kServiceNotFound, ServName + " is not exist!");
+            return;
+        }
+        auto methit = it->second._methodInfoMap.find(MethName);
+        if (methit == it->second._methodInfoMap.end())
+        {
+            LOG_ERROR("%s is not exist!", MethName.c_str());
+            SendErrorResponse(conn, requestId, kMethodNotFound, MethName + " is not exist!");
+            return;
+        }
+        info = &methit->second;
     }
-    google::protobuf::Service *service = it->second._service;
-    const google::protobuf::MethodDescriptor *method = methit->second;
+    google::protobuf::Service *service = info->_service;
+    const google::protobuf::MethodDescriptor *method = info->_descriptor;
+
+    LOG_DEBUG("request_id:%lu method:%s args_size:%lu", static_cast<unsigned long>(requestId),
+              method->full_name().c_str(), static_cast<unsigned long>(argsSize));
 
-    // 生成request请求
-    google::protobuf::Message *request = service->GetRequestPrototype(method).New();
-    
+    // request、response和完成回调都分配在同一个调用arena上，响应发出后整体归还
+    MprpcCallArena *arena = _arenaPool.Acquire();
+    google::protobuf::Message *request = service->GetRequestPrototype(method).New(arena->Get());
 
     //获取方法参数的字符流数据
-    if (!request->ParseFromString(argsStr))
+    if (!request->ParseFromArray(args, static_cast<int>(argsSize)))
     {
-        LOG_ERROR("request parse error, content: %s", argsStr.c_str());
+        LOG_ERROR("request parse error, method: %s", method->full_name().c_str());
+        _monitor->RecordRequest(info->_monitorId, false, 0);
+        _arenaPool.Release(arena);
+        SendErrorResponse(conn, requestId, kRequestParseError, "request parse error");
         return;
     }
 
-    //生成response请求
-    google::protobuf::Message *response = service->GetResponsePrototype(method).New();
-
-    //给method的调用绑定一个回调
-    //template <typename Class, typename Arg1, typename Arg2>
-    google::protobuf::Closure *done = google::protobuf::NewCallback<MprpcProvider, 
-                                                                    const muduo::net::TcpConnectionPtr&,
-                                                                    google::protobuf::Message*>
-                                                                    (this, 
-                                                                    &MprpcProvider::SendmprpcResponse,
-                                                                    conn,
-                                                                    response);
-
-    //根据远端请求字符流，将请求分配到该节点上发布的相应方法
-    service->CallMethod(method, nullptr, request, response, done);
+    // 参数已在IO线程从接收缓冲区反序列化，方法交给执行器在工作线程执行
+    RpcCall *call = google::protobuf::Arena::Create<RpcCall>(arena->Get(), this, arena, conn, info, request, requestId, echoMethodId,
+                                                                 header.timeout_ms());
+    uint64_t connKey = reinterpret_cast<uintptr_t>(conn.get());
+    if (!_executor.Submit(info->_executorId, connKey, [call]() { call->Execute(); }))
+    {
+        // 过载时每个请求都会被拒绝，采样写日志，拒绝总数见监控
+        LOG_ERROR_EVERY_N(kOverloadLogSample, "executor queue is full, reject %s", method->full_name().c_str());
+        _monitor->RecordRequest(info->_monitorId, false, 0);
+        _arenaPool.Release(arena);
+        SendErrorResponse(conn, requestId, kServerBusy, "server busy");
+    }
 
 }
 
-// Closure的回调操作，用于序列化rpc的响应和网络发送
-void MprpcProvider::SendmprpcResponse(const muduo::net::TcpConnectionPtr &conn, google::protobuf::Message *response)
+// 组帧发送，响应直接序列化进发送缓冲区
+// 在IO线程中使用按线程复用的缓冲区并直接写socket；在工作线程中编码到新缓冲区后整体移交给IO线程
+static bool SendFrame(const muduo::net::TcpConnectionPtr &conn, mprpc::mpRpcHeader &header, const google::protobuf::Message *body)
 {
-    std::string responseStr;
-    // response进行序列化
-    if(response->SerializePartialToString(&responseStr))
+    if (conn->getLoop()->isInLoopThread())
     {
-        //序列化成功后 通过框架网络返回
-        conn->send(responseStr);
+        thread_local std::string sendBuf;
+        sendBuf.clear();
+        if (!MprpcCodec::Encode(header, body, &sendBuf))
+        {
+            return false;
+        }
+        conn->send(sendBuf);
+        return true;
     }
-    else
+    std::string sendBuf;
+    if (!MprpcCodec::Encode(header, body, &sendBuf))
+    {
+        return false;
+    }
+    MprpcCodec::Send(conn, std::move(sendBuf));
+    return true;
+}
+
+// Closure的回调操作，用于序列化rpc的响应和网络发送
+bool MprpcProvider::SendmprpcResponse(const muduo::net::TcpConnectionPtr &conn, google::protobuf::Message *response, uint64_t requestId, uint32_t methodId)
+{
+    // response直接序列化进发送缓冲区，通过框架网络返回，连接保持以便复用
+    mprpc::mpRpcHeader header;
+    header.set_request_id(requestId);
+    header.set_method_id(methodId);
+    if (!SendFrame(conn, header, response))
     {
         LOG_ERROR("serialize response_str error!" );
+        SendErrorResponse(conn, requestId, kResponseSerializeError, "serialize response error");
+        return false;
     }
-    //清理资源
-    delete response;
-    conn->shutdown();
-    
+    // response属于调用arena，由RpcCall统一归还
+    return true;
+}
+
+// 框架层错误，只回header
+void MprpcProvider::SendErrorResponse(const muduo::net::TcpConnectionPtr &conn, uint64_t requestId, int errorCode, const std::string &errorText, uint32_t methodId)
+{
+    mprpc::mpRpcHeader header;
+    header.set_request_id(requestId);
+    header.set_method_id(methodId);
+    header.set_error_code(errorCode);
+    header.set_error_text(errorText);
+    SendFrame(conn, header, nullptr);
 }
 
 
@@ -185,31 +417,52 @@ void MprpcProvider::NotifyService(google::protobuf::Service *service)
         const google::protobuf::MethodDescriptor *pMethDsc = pSerDsc->method(i);
         std::string MethName = pMethDsc->name();
         // 储存方法
-        method_struct._methodInfoMap.insert({MethName, pMethDsc});
+        MethodInfo methodInfo;
+        methodInfo._service = service;
+        methodInfo._descriptor = pMethDsc;
+        methodInfo._name = SerName + "." + MethName;
+        methodInfo._executorId = _executor.RegisterMethod(methodInfo._name);
+        methodInfo._monitorId = _monitor->RegisterMethod(methodInfo._name);
+        methodInfo._methodId = MprpcCodec::MethodId(pMethDsc);
+        method_struct._methodInfoMap.insert({MethName, methodInfo});
 
         //打印日志
         LOG_INFO("method_name:%s", MethName.c_str());
 
     }
     // 存储服务
-    _serviceInfo.insert({SerName, method_struct});
-}
-
-//解析header头
-bool MprpcProvider::Paresrpcheader(const std::string& headerstr, std::string& serviceName, std::string& methodName, uint32_t& argsSize){
-    mprpc::mpRpcHeader mprpcHeader;
-    if (!mprpcHeader.ParseFromString(headerstr))
+    auto result = _serviceInfo.insert({SerName, method_struct});
+    if (!result.second)
     {
-        // 反序列化失败
-        LOG_ERROR("rpc_header_str parse error!");
-        return false;
+        LOG_ERROR("%s is already notified!", SerName.c_str());
+        return;
     }
 
-    // 反序列化成功
-    serviceName = mprpcHeader.service_name();
-    methodName = mprpcHeader.method_name();
-    argsSize = mprpcHeader.args_size();
-    return true;
+    // 登记到按方法id排序的分发表，unordered_map的元素地址在插入后保持不变
+    for (auto &mp : result.first->second._methodInfoMap)
+    {
+        const MethodInfo *info = &mp.second;
+        auto pos = std::lower_bound(_methodTable.begin(), _methodTable.end(), info->_methodId,
+                                    [](const std::pair<uint32_t, const MethodInfo *> &entry, uint32_t id) { return entry.first < id; });
+        if (pos != _methodTable.end() && pos->first == info->_methodId)
+        {
+            // 哈希冲突，冲突的方法都只能按名字调用
+            LOG_ERROR("method id conflict: %s", info->_descriptor->full_name().c_str());
+            pos->second = nullptr;
+            continue;
+        }
+        _methodTable.insert(pos, {info->_methodId, info});
+    }
+}
 
-    
+// 按方法id查分发表
+const MprpcProvider::MethodInfo *MprpcProvider::FindMethod(uint32_t methodId) const
+{
+    auto pos = std::lower_bound(_methodTable.begin(), _methodTable.end(), methodId,
+                                [](const std::pair<uint32_t, const MethodInfo *> &entry, uint32_t id) { return entry.first < id; });
+    if (pos == _methodTable.end() || pos->first != methodId)
+    {
+        return nullptr;
+    }
+    return pos->second;
 }
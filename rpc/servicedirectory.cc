@@ -0,0 +1,231 @@
+#include "servicedirectory.h"
+#include "logger.h"
+#include <cstdlib>
+
+// 后台线程检查会话的间隔，会话过期时立即唤醒
+static const int kReconnectIntervalSec = 3;
+
+// 解析 ip:port
+static bool ParseAddr(const std::string &hostData, ServiceAddr &addr)
+{
+    size_t idx = hostData.rfind(':');
+    if (idx == std::string::npos || idx == 0 || idx + 1 == hostData.size())
+    {
+        return false;
+    }
+    addr.ip = hostData.substr(0, idx);
+    addr.port = atoi(hostData.c_str() + idx + 1);
+    return addr.port != 0;
+}
+
+const int ServiceDirectory::kNegativeCacheMs;
+
+ServiceDirectory &ServiceDirectory::GetInstance()
+{
+    static ServiceDirectory directory;
+    return directory;
+}
+
+ServiceDirectory::ServiceDirectory() : _version(0), _sessionLost(false), _running(true)
+{
+    _zkcli.SetWatchCallback([this](const std::string &path) { OnWatch(path); });
+    // 首次建立会话在构造时等待，之后由后台线程维护，查询路径上不再等待连接
+    _zkcli.Start();
+    _sessionThread = std::thread([this]() { SessionLoop(); });
+}
+
+ServiceDirectory::~ServiceDirectory()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        _running = false;
+    }
+    _sessionCond.notify_all();
+    _sessionThread.join();
+}
+
+// 查询提供service.method的全部节点
+ServiceDirectory::AddrList ServiceDirectory::Lookup(const std::string &serviceName, const std::string &methodName)
+{
+    // /service_name/method_name
+    std::string methodPath;
+    methodPath.reserve(serviceName.size() + methodName.size() + 2);
+    methodPath += '/';
+    methodPath += serviceName;
+    methodPath += '/';
+    methodPath += methodName;
+
+    uint64_t version;
+    AddrList stale;
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        auto it = _cache.find(methodPath);
+        if (it != _cache.end())
+        {
+            if (std::chrono::steady_clock::now() < it->second.expire)
+            {
+                return it->second.addrs->empty() ? nullptr : it->second.addrs;
+            }
+            stale = it->second.addrs;
+        }
+        version = _version;
+    }
+
+    AddrList addrs;
+    Entry entry{nullptr, std::chrono::steady_clock::time_point::max()};
+    if (Load(methodPath, addrs))
+    {
+        entry.addrs = addrs;
+    }
+    else if (stale && !stale->empty())
+    {
+        // zk不可用，继续使用旧的节点列表，节点失效由熔断器处理
+        entry.addrs = stale;
+        entry.expire = std::chrono::steady_clock::now() + std::chrono::milliseconds(kNegativeCacheMs);
+    }
+    else
+    {
+        entry.addrs = addrs;
+    }
+    if (entry.addrs->empty())
+    {
+        // Load设置了子节点watch(方法节点存在)或exists watch(不存在)，节点上线时提前失效；
+        // zk不可用时没有watch，只能等expire
+        entry.expire = std::chrono::steady_clock::now() + std::chrono::milliseconds(kNegativeCacheMs);
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        if (_version == version)
+        {
+            _cache[methodPath] = entry;
+        }
+    }
+    return entry.addrs->empty() ? nullptr : entry.addrs;
+}
+
+// 缓存的方法数
+size_t ServiceDirectory::Size() const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _cache.size();
+}
+
+// 缓存中出现的全部节点
+std::unordered_set<std::string> ServiceDirectory::Endpoints() const
+{
+    std::unordered_set<std::string> endpoints;
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    for (const auto &item : _cache)
+    {
+        for (const ServiceAddr &addr : *item.second.addrs)
+        {
+            endpoints.insert(addr.ip + ":" + std::to_string(addr.port));
+        }
+    }
+    return endpoints;
+}
+
+// 从zk读取节点列表并设置watch
+bool ServiceDirectory::Load(const std::string &path, AddrList &result)
+{
+    auto addrs = std::make_shared<std::vector<ServiceAddr>>();
+    result = addrs;
+    std::lock_guard<std::mutex> lock(_zkMutex);
+    if (!_zkcli.Connected())
+    {
+        // 会话由后台线程恢复，这里不等待
+        return false;
+    }
+
+    // 每个节点注册为方法下的临时子节点 /service_name/method_name/ip:port
+    std::vector<std::string> children;
+    if (!_zkcli.GetChildren(path.c_str(), children, true))
+    {
+        // 节点不存在时zoo_get_children不会设置watch，改用exists watch等待节点创建
+        if (_zkcli.Exists(path.c_str(), true))
+        {
+            // 节点存在却读取失败
+            return false;
+        }
+        LOG_ERROR("method is not exist: %s", path.c_str());
+        return true;
+    }
+    for (const std::string &child : children)
+    {
+        ServiceAddr addr;
+        if (ParseAddr(child, addr))
+        {
+            addrs->push_back(addr);
+        }
+        else
+        {
+            LOG_ERROR(" address is invalid! %s/%s", path.c_str(), child.c_str());
+        }
+    }
+    // 兼容旧的注册方式：地址直接写在方法节点的数据中
+    if (children.empty())
+    {
+        ServiceAddr addr;
+        if (ParseAddr(_zkcli.GetData(path.c_str(), true), addr))
+        {
+            addrs->push_back(addr);
+        }
+    }
+    if (addrs->empty())
+    {
+        LOG_ERROR("no provider for %s", path.c_str());
+    }
+    return true;
+}
+
+// 节点变化通知，path为空表示会话过期
+void ServiceDirectory::OnWatch(const std::string &path)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        ++_version;
+        if (!path.empty())
+        {
+            _cache.erase(path);
+            return;
+        }
+        // watch全部失效：保留地址供会话恢复前使用，标记过期以便恢复后重新读取并设置watch
+        auto now = std::chrono::steady_clock::now();
+        for (auto &item : _cache)
+        {
+            item.second.expire = now;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        _sessionLost = true;
+    }
+    _sessionCond.notify_one();
+}
+
+// 后台线程：会话过期或句柄不存在时重新发起连接；断线重连由zk客户端自行完成
+void ServiceDirectory::SessionLoop()
+{
+    std::unique_lock<std::mutex> lock(_sessionMutex);
+    while (_running)
+    {
+        _sessionCond.wait_for(lock, std::chrono::seconds(kReconnectIntervalSec),
+                              [this]() { return !_running || _sessionLost; });
+        if (!_running)
+        {
+            break;
+        }
+        _sessionLost = false;
+        lock.unlock();
+        {
+            // StartAsync只替换句柄不等待连接，查询最多等待这一小段
+            std::lock_guard<std::mutex> zkLock(_zkMutex);
+            if (_zkcli.NeedRestart())
+            {
+                LOG_INFO("zookeeper session lost, reconnecting");
+                _zkcli.StartAsync();
+            }
+        }
+        lock.lock();
+    }
+}
@@ -3,19 +3,35 @@
 //#define THREADED
 
 // 全局的watcher观察器   zkserver给zkclient的通知
-// watcher线程  
+// watcher线程  上下文为ZkClient对象
 void global_watcher(zhandle_t *zh, int type,
                     int state, const char *path, void *watcherCtx)
 {
+    ZkClient *client = (ZkClient*)zoo_get_context(zh);
+    if (client == nullptr)
+    {
+        return;
+    }
     //链接成功了 会下发回调 查看type 和state 改变信号量
     if(type == ZOO_SESSION_EVENT)
     {
+        client->_connected = (state == ZOO_CONNECTED_STATE);
         if(state == ZOO_CONNECTED_STATE)
         {
             // zkclient和zkserver连接成功
-            sem_t *sem = (sem_t*)zoo_get_context(zh);
-            sem_post(sem);
+            sem_post(&client->_sem);
+        }
+        else if (state == ZOO_EXPIRED_SESSION_STATE)
+        {
+            // 会话过期，临时节点和watch全部失效
+            LOG_ERROR("ZooKeeper session expired");
+            client->_expired = true;
+            if (client->_watchCallback)
+            {
+                client->_watchCallback("");
+            }
         }
+        return;
     }
     else if (type == ZOO_CREATED_EVENT)
     {
@@ -29,13 +45,23 @@ void global_watcher(zhandle_t *zh, int type,
     {
         LOG_INFO("ZooKeeper node changed");
     }
+    else if (type == ZOO_CHILD_EVENT)
+    {
+        LOG_INFO("ZooKeeper node children changed");
+    }
+    // 节点变化 通知使用者
+    if (path != nullptr && client->_watchCallback)
+    {
+        client->_watchCallback(path);
+    }
 
 }
 
 
 //初始化
-ZkClient::ZkClient() : _zhandle(nullptr)
+ZkClient::ZkClient() : _zhandle(nullptr), _expired(false), _connected(false)
 {
+    sem_init(&_sem, 0, 0);
 }
 
 //关闭
@@ -45,12 +71,14 @@ ZkClient::~ZkClient()
     {
         zookeeper_close(_zhandle);
     }
+    sem_destroy(&_sem);
 }
 
 // 重连
 void ZkClient::Reconnect(){
     if(_zhandle!=nullptr){
         zookeeper_close(_zhandle);
+        _zhandle = nullptr;
     }
     Start();
 }
@@ -58,27 +86,18 @@ void ZkClient::Reconnect(){
 // zkclient启动连接zkserver
 void ZkClient::Start()
 {
-    std::string host = MprpcApplication::GetConfig().LoadConfig("zookeeperip");
-    std::string port = MprpcApplication::GetConfig().LoadConfig("zookeeperport");
-    std::string constr = host + ":" + port;
-
-    // 创建句柄
-    _zhandle = zookeeper_init(constr.c_str(), global_watcher, 30000, nullptr, nullptr, 0);
+    StartAsync();
     if (nullptr == _zhandle)
     {
-        LOG_ERROR("zookeeper_init error!");
+        return;
     }
-    // 信号量 等待连接
-    sem_t sem;
-    sem_init(&sem, 0, 0);
-    zoo_set_context(_zhandle, &sem);
 
     //最多等待10秒
     struct timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
     ts.tv_sec += 10;
 
-    if(sem_timedwait(&sem, &ts) == -1){
+    if(sem_timedwait(&_sem, &ts) == -1){
         LOG_ERROR("zookeeper_init timeout!");
         zookeeper_close(_zhandle);
         _zhandle = nullptr;
@@ -87,6 +106,33 @@ void ZkClient::Start()
     LOG_INFO("zookeeper_init success!");
 }
 
+// 发起连接，不等待会话建立
+void ZkClient::StartAsync()
+{
+    if (_zhandle != nullptr)
+    {
+        // 会话过期后重新建立
+        zookeeper_close(_zhandle);
+        _zhandle = nullptr;
+    }
+    _expired = false;
+    _connected = false;
+    while (sem_trywait(&_sem) == 0)
+    {
+    }
+
+    std::string host = MprpcApplication::GetConfig().LoadConfig("zookeeperip");
+    std::string port = MprpcApplication::GetConfig().LoadConfig("zookeeperport");
+    std::string constr = host + ":" + port;
+
+    // 创建句柄，上下文在初始化时传入，避免连接事件先于设置上下文到达
+    _zhandle = zookeeper_init(constr.c_str(), global_watcher, 30000, nullptr, this, 0);
+    if (nullptr == _zhandle)
+    {
+        LOG_ERROR("zookeeper_init error!");
+    }
+}
+
 
 // 在zkserver上根据指定的path创建znode节点
 void ZkClient::Create(const char *path, const char *data, int datalen, int state)
@@ -125,15 +171,15 @@ void ZkClient::Create(const char *path, const char *data, int datalen, int state
 
 }
 // 根据参数指定的znode节点路径，获取znode节点的值
-std::string ZkClient::GetData(const char *path)
+std::string ZkClient::GetData(const char *path, bool watch)
 {
     if(_zhandle==nullptr){
         LOG_ERROR("zookeeper_init error!");
         return "";
     }
     char buffer[64] ={0};
-    int Buflen = sizeof(buffer);
-    int flag = zoo_get(_zhandle, path, 0, buffer, &Buflen, nullptr);
+    int Buflen = sizeof(buffer) - 1;
+    int flag = zoo_get(_zhandle, path, watch ? 1 : 0, buffer, &Buflen, nullptr);
     if (flag != ZOK)
 	{
         LOG_ERROR("zoo_get error!");
@@ -142,6 +188,47 @@ std::string ZkClient::GetData(const char *path)
 	}
 	else
 	{
-		return buffer;
+		return std::string(buffer, Buflen > 0 ? Buflen : 0);
 	}
-}
\ No newline at end of file
+}
+
+// 获取子节点列表
+bool ZkClient::GetChildren(const char *path, std::vector<std::string> &children, bool watch)
+{
+    children.clear();
+    if(_zhandle==nullptr){
+        LOG_ERROR("zookeeper_init error!");
+        return false;
+    }
+    struct String_vector strings;
+    int flag = zoo_get_children(_zhandle, path, watch ? 1 : 0, &strings);
+    if (flag != ZOK)
+    {
+        if (flag != ZNONODE)
+        {
+            LOG_ERROR("zoo_get_children error! path:%s", path);
+        }
+        return false;
+    }
+    for (int i = 0; i < strings.count; ++i)
+    {
+        children.emplace_back(strings.data[i]);
+    }
+    deallocate_String_vector(&strings);
+    return true;
+}
+
+// 节点是否存在
+bool ZkClient::Exists(const char *path, bool watch)
+{
+    if(_zhandle==nullptr){
+        LOG_ERROR("zookeeper_init error!");
+        return false;
+    }
+    int flag = zoo_exists(_zhandle, path, watch ? 1 : 0, nullptr);
+    if (flag != ZOK && flag != ZNONODE)
+    {
+        LOG_ERROR("zoo_exists error! path:%s", path);
+    }
+    return flag == ZOK;
+}
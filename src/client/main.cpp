@@ -38,6 +38,10 @@ bool isMainMenuRunning = false;
 
 // 接收线程
 void readTaskHandler(int clientfd);
+// 按换行分帧发送一条消息
+int sendMsg(int clientfd, const string &msg);
+// 处理一条完整的服务端消息
+void handleServerMsg(const string &msg);
 // 处理登录的响应逻辑
 void doLoginResponse(json &);
 // 处理注册的响应逻辑
@@ -123,11 +127,13 @@ int main(int argc, char **argv)
             js["msgid"] = LOGIN_MSG;
             js["id"] = id;
             js["password"] = pwd;
+            // 好友和群组以原生json数组返回
+            js["nested"] = true;
             string request = js.dump();
 
             g_isLoginSuccess = false;
 
-            int len = send(clientfd, request.c_str(), strlen(request.c_str()), 0);
+            int len = sendMsg(clientfd, request);
             if (len == -1)
             {
                 cerr << "send login msg error:" << request << endl;
@@ -158,7 +164,7 @@ int main(int argc, char **argv)
             js["password"] = pwd;
             string request = js.dump();
 
-            int len = send(clientfd, request.c_str(), strlen(request.c_str()) + 1, 0);
+            int len = sendMsg(clientfd, request);
             if (len == -1)
             {
                 cerr << "send reg msg error:" << request << endl;
@@ -181,60 +187,96 @@ int main(int argc, char **argv)
     }
 }
 
+// 按换行分帧发送一条消息
+int sendMsg(int clientfd, const string &msg)
+{
+    string frame = msg + "\n";
+    size_t sent = 0;
+    while (sent < frame.size())
+    {
+        int len = send(clientfd, frame.c_str() + sent, frame.size() - sent, 0);
+        if (-1 == len)
+        {
+            return -1;
+        }
+        sent += len;
+    }
+    return sent;
+}
+
 // 子线程 - 接收线程
 void readTaskHandler(int clientfd)
 {
+    // 未凑成完整帧的数据
+    string pending;
     for (;;)
     {
-        char buffer[1024] = {0};
-        int len = recv(clientfd, buffer, 1024, 0);
+        char buffer[4096] = {0};
+        int len = recv(clientfd, buffer, sizeof(buffer), 0);
         if (-1 == len || 0 == len)
         {
             close(clientfd);
             exit(-1);
         }
+        pending.append(buffer, len);
 
-        // 接收ChatServer转发的数据，反序列化生成json数据对象
-        json js = json::parse(buffer);
-        // 解码消息类型
-        int msgtype = js["msgid"].get<int>();
-        // 聊天
-        if (ONE_CHAT_MSG == msgtype)
-        {
-            cout << js["time"].get<string>() << " [" << js["id"] << "]" << js["name"].get<string>()
-                 << " said: " << js["msg"].get<string>() << endl;
-            continue;
-        }
-        // 群聊
-        if (GROUP_CHAT_MSG == msgtype)
+        // 一次处理所有完整的帧
+        size_t pos;
+        while ((pos = pending.find('\n')) != string::npos)
         {
-            cout << "群消息[" << js["groupid"] << "]:" << js["time"].get<string>() << " [" << js["id"] << "]" << js["name"].get<string>()
-                 << " said: " << js["msg"].get<string>() << endl;
-            continue;
-        }
-        // 添加
-        if (ADD_FRIEND_ACK == msgtype)
-        {
-            doAddResponse(js);
-            continue;
-        }
-        // 登录
-        if (LOGIN_MSG_ACK == msgtype)
-        {
-            doLoginResponse(js); // 处理登录响应的业务逻辑
-            sem_post(&rwsem);    // 通知主线程，登录结果处理完成
-            continue;
-        }
-        // 注册
-        if (REG_MSG_ACK == msgtype)
-        {
-            doRegResponse(js);
-            sem_post(&rwsem); // 通知主线程，注册结果处理完成
-            continue;
+            string msg = pending.substr(0, pos);
+            pending.erase(0, pos + 1);
+            if (!msg.empty())
+            {
+                handleServerMsg(msg);
+            }
         }
     }
 }
 
+// 处理一条完整的服务端消息
+void handleServerMsg(const string &msg)
+{
+    // 接收ChatServer转发的数据，反序列化生成json数据对象
+    json js = json::parse(msg);
+    // 解码消息类型
+    int msgtype = js["msgid"].get<int>();
+    // 聊天
+    if (ONE_CHAT_MSG == msgtype)
+    {
+        cout << js["time"].get<string>() << " [" << js["id"] << "]" << js["name"].get<string>()
+             << " said: " << js["msg"].get<string>() << endl;
+        return;
+    }
+    // 群聊
+    if (GROUP_CHAT_MSG == msgtype)
+    {
+        cout << "群消息[" << js["groupid"] << "]:" << js["time"].get<string>() << " [" << js["id"] << "]" << js["name"].get<string>()
+             << " said: " << js["msg"].get<string>() << endl;
+        return;
+    }
+    // 添加
+    if (ADD_FRIEND_ACK == msgtype)
+    {
+        doAddResponse(js);
+        return;
+    }
+    // 登录
+    if (LOGIN_MSG_ACK == msgtype)
+    {
+        doLoginResponse(js); // 处理登录响应的业务逻辑
+        sem_post(&rwsem);    // 通知主线程，登录结果处理完成
+        return;
+    }
+    // 注册
+    if (REG_MSG_ACK == msgtype)
+    {
+        doRegResponse(js);
+        sem_post(&rwsem); // 通知主线程，注册结果处理完成
+        return;
+    }
+}
+
 // 处理注册的响应逻辑
 void doRegResponse(json &responsejs)
 {
@@ -262,6 +304,12 @@ void doAddResponse(json &responsejs)
     }
 }
 
+// 登录响应中的元素，旧服务端返回json字符串，新服务端返回json对象
+static json toObject(const json &element)
+{
+    return element.is_string() ? json::parse(element.get<string>()) : element;
+}
+
 // 处理登录的响应逻辑
 void doLoginResponse(json &responsejs)
 {
@@ -283,10 +331,9 @@ void doLoginResponse(json &responsejs)
             // 初始化
             g_currentUserFriendList.clear();
 
-            vector<string> vec = responsejs["friends"];
-            for (string &str : vec)
+            for (const json &element : responsejs["friends"])
             {
-                json js = json::parse(str);
+                json js = toObject(element);
                 User user;
                 user.setId(js["id"].get<int>());
                 user.setName(js["name"]);
@@ -300,20 +347,18 @@ void doLoginResponse(json &responsejs)
         {
             // 初始化
             g_currentUserGroupList.clear();
-            vector<string> vec1 = responsejs["groups"];
-            for (string &groupstr : vec1)
+            for (const json &groupElement : responsejs["groups"])
             {
-                json grpjs = json::parse(groupstr);
+                json grpjs = toObject(groupElement);
                 Group group;
                 group.setId(grpjs["groupid"].get<int>());
                 group.setName(grpjs["groupname"]);
                 group.setDesc(grpjs["groupdesc"]);
 
-                vector<string> vec2 = grpjs["groupuser"];
-                for (string &userstr : vec2)
+                for (const json &userElement : grpjs["groupuser"])
                 {
                     GroupUser user;
-                    json js = json::parse(userstr);
+                    json js = toObject(userElement);
                     user.setId(js["id"].get<int>());
                     user.setName(js["name"]);
                     user.setState(js["state"]);
@@ -482,7 +527,7 @@ void chat(int clientfd, string str)
     js["time"] = getCurrentTime();
     string buffer = js.dump();
 
-    int len = send(clientfd, buffer.c_str(), strlen(buffer.c_str()) + 1, 0);
+    int len = sendMsg(clientfd, buffer);
     if (-1 == len)
     {
         cerr << "send chat msg error -> " << buffer << endl;
@@ -499,7 +544,7 @@ void addfriend(int clientfd, string str)
     js["id"] = g_currentUser.getId();
     string buffer = js.dump();
 
-    int len = send(clientfd, buffer.c_str(), strlen(buffer.c_str()) + 1, 0);
+    int len = sendMsg(clientfd, buffer);
     if (-1 == len)
     {
         cerr << "send addfriend msg error -> " << buffer << endl;
@@ -526,7 +571,7 @@ void creategroup(int clientfd, string str)
     js["groupdesc"] = groupdesc;
     string buffer = js.dump();
 
-    int len = send(clientfd, buffer.c_str(), strlen(buffer.c_str()) + 1, 0);
+    int len = sendMsg(clientfd, buffer);
     if (-1 == len)
     {
         cerr << "send creategroup msg error -> " << buffer << endl;
@@ -545,7 +590,7 @@ void addgroup(int clientfd, string str)
     js["groupid"] = groupid;
     string buffer = js.dump();
 
-    int len = send(clientfd, buffer.c_str(), strlen(buffer.c_str()) + 1, 0);
+    int len = sendMsg(clientfd, buffer);
     if (-1 == len)
     {
         cerr << "send addgroup msg error -> " << buffer << endl;
@@ -575,7 +620,7 @@ void groupchat(int clientfd, string str)
     js["time"] = getCurrentTime();
     string buffer = js.dump();
 
-    int len = send(clientfd, buffer.c_str(), strlen(buffer.c_str()) + 1, 0);
+    int len = sendMsg(clientfd, buffer);
     if (-1 == len)
     {
         cerr << "send groupchat msg error -> " << buffer << endl;
@@ -590,7 +635,7 @@ void loginout(int clientfd, string str)
     js["id"] = g_currentUser.getId();
     string buffer = js.dump();
 
-    int len = send(clientfd, buffer.c_str(), strlen(buffer.c_str()) + 1, 0);
+    int len = sendMsg(clientfd, buffer);
     if (-1 == len)
     {
         cerr << "send loginout msg error -> " << buffer << endl;
@@ -0,0 +1,126 @@
+#include "businesspool.hpp"
+
+BusinessPool::BusinessPool(int threadNum, int maxQueueSize)
+    : _threadNum(threadNum), _maxQueueSize(maxQueueSize), _pending(0), _running(false)
+{
+}
+
+BusinessPool::~BusinessPool()
+{
+    stop();
+}
+
+// 启动工作线程
+void BusinessPool::start()
+{
+    if (_threadNum <= 0)
+    {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(_mutex);
+        _running = true;
+    }
+    for (int i = 0; i < _threadNum; ++i)
+    {
+        _workers.emplace_back(&BusinessPool::workerLoop, this);
+    }
+}
+
+// 停止工作线程
+void BusinessPool::stop()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        if (!_running)
+        {
+            return;
+        }
+        _running = false;
+    }
+    // 工作线程执行完已提交的任务后退出；之后提交的任务在调用线程执行
+    _notEmpty.notify_all();
+    _notFull.notify_all();
+    for (thread &worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+// 提交任务
+void BusinessPool::run(size_t key, Task task)
+{
+    unique_lock<mutex> lock(_mutex);
+    if (_running && _pending >= _maxQueueSize)
+    {
+        // 反压：阻塞IO线程直到工作线程腾出名额
+        _notFull.wait(lock, [this]()
+                      { return _pending < _maxQueueSize || !_running; });
+    }
+    // 停止后工作线程可能已经退出，这里不再入队
+    if (!_running)
+    {
+        lock.unlock();
+        task();
+        return;
+    }
+
+    ++_pending;
+    auto it = _strands.find(key);
+    if (it != _strands.end())
+    {
+        // 该key已有任务在执行或就绪，排在其后
+        it->second.push_back(std::move(task));
+        return;
+    }
+    _strands.emplace(key, deque<Task>());
+    _ready.push_back(Item{key, std::move(task)});
+    _notEmpty.notify_one();
+}
+
+// 放行该key的下一个任务
+void BusinessPool::finish(size_t key)
+{
+    auto it = _strands.find(key);
+    if (it->second.empty())
+    {
+        _strands.erase(it);
+        return;
+    }
+    _ready.push_back(Item{key, std::move(it->second.front())});
+    it->second.pop_front();
+    _notEmpty.notify_one();
+}
+
+// 工作线程
+void BusinessPool::workerLoop()
+{
+    unique_lock<mutex> lock(_mutex);
+    while (true)
+    {
+        _notEmpty.wait(lock, [this]()
+                       { return !_ready.empty() || (!_running && _strands.empty()); });
+        if (_ready.empty())
+        {
+            // 已停止，且排在strand中的任务也都执行完了
+            break;
+        }
+        Item item = std::move(_ready.front());
+        _ready.pop_front();
+        --_pending;
+        _notFull.notify_one();
+        lock.unlock();
+
+        item.task();
+        item.task = nullptr;
+
+        lock.lock();
+        finish(item.key);
+        if (!_running && _strands.empty())
+        {
+            // 唤醒其他等待退出的工作线程
+            _notEmpty.notify_all();
+        }
+    }
+}
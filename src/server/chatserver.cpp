@@ -3,6 +3,8 @@
 #include "chatserver.hpp"
 #include "json.hpp"
 #include"chatservice.hpp"
+#include "chatsession.hpp"
+#include <muduo/base/Logging.h>
 
 using namespace std;
 using namespace placeholders;
@@ -10,43 +12,79 @@ using json = nlohmann::json;
 
 ChatServer::ChatServer(EventLoop *loop,               // 循环
                        const InetAddress &listenAddr, // IP+Port
-                       const string &nameArg)
-    : _server(loop, listenAddr, nameArg), _loop(loop)
+                       const string &nameArg,
+                       MessageCodec::FrameType frameType,
+                       char delimiter,
+                       int workerNum)
+    : _businessPool(workerNum), _server(loop, listenAddr, nameArg), _loop(loop),
+      _codec(frameType, std::bind(&ChatServer::onFrame, this, _1, _2, _3), delimiter),
+      _nextConnId(0)
 {
     // 注册链接创建断开回调
     _server.setConnectionCallback(std::bind(&ChatServer::onConnection, this, _1));
-    // 注册读写事件回调
-    _server.setMessageCallback(std::bind(&ChatServer::onMessage, this, _1, _2, _3));
+    // 注册读写事件回调，由编解码器完成分帧
+    _server.setMessageCallback(std::bind(&MessageCodec::onMessage, &_codec, _1, _2, _3));
     // 设置服务器线程数
     _server.setThreadNum(4);
+    // 用监听地址标识本服务器，用户状态通知中携带
+    Chatservice::instance()->start(listenAddr.toIpPort());
 }
 
 ////启动服务
 void ChatServer::start(){
+    _businessPool.start();
     _server.start();
+    // 定期输出运行指标
+    _loop->runEvery(60.0, []()
+                    { Chatservice::instance()->reportStats(); });
 }
 
 // 上报链接相关信息
 void ChatServer::onConnection(const TcpConnectionPtr &conn)
 {
-    if (!conn->connected())
+    if (conn->connected())
     {
-        Chatservice::instance()->clientCloseException(conn);
+        // 建立连接会话，记录该连接使用的编解码器
+        conn->setContext(std::make_shared<ChatSession>(&_codec, _nextConnId++));
+    }
+    else
+    {
+        // 与该连接之前的消息在同一strand中排队，保证清理发生在它们之后
+        ChatSession *session = getChatSession(conn);
+        size_t key = session != nullptr ? session->connid : 0;
+        _businessPool.run(key, [conn]()
+                          { Chatservice::instance()->clientCloseException(conn); });
         conn->shutdown();
     }
 }
 
-// 上报读写相关信息
-void ChatServer::onMessage(const TcpConnectionPtr &conn,
-                           Buffer *buffer,
-                           Timestamp time)
+// 上报一个完整的消息帧
+void ChatServer::onFrame(const TcpConnectionPtr &conn,
+                         string &frame,
+                         Timestamp time)
 {
-    // 接收缓冲区数据
-    string buf = buffer->retrieveAllAsString();
-    // 数据反序列化
-    json js = json::parse(buf);
-    //通过js[msg_id]获得业务hanlder
-    auto msghandler = Chatservice::instance()->getHandler(js["msgid"].get<int>());
-    msghandler(conn, js,time);
+    json js;
+    try {
+        // 数据反序列化
+        js = json::parse(frame);
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << conn->name() << " failed to parse message: " << e.what();
+        return;
+    }
+
+    // 交给业务线程处理，同一连接的消息按序执行，慢消息只阻塞它自己的连接
+    ChatSession *session = getChatSession(conn);
+    size_t key = session != nullptr ? session->connid : 0;
+    _businessPool.run(key, [conn, js, time]() mutable {
+        try {
+            //通过js[msg_id]获得业务hanlder
+            auto msghandler = Chatservice::instance()->getHandler(js["msgid"].get<int>());
+            msghandler(conn, js,time);
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR << conn->name() << " failed to handle message: " << e.what();
+        }
+    });
 
 }
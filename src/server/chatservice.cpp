@@ -1,11 +1,20 @@
 #include "chatservice.hpp"
 #include "public.hpp"
+#include "chatsession.hpp"
+#include "loginresponse.hpp"
 #include <muduo/base/Logging.h>
+#include <iterator>
+#include <sstream>
 
 using namespace muduo;
 using namespace placeholders;
 using namespace std;
 
+// 用户状态通知的redis通道
+static const char *kPresenceChannel = "presence";
+// 群成员变更的redis通道
+static const char *kGroupChannel = "groupmember";
+
 // 单例对象的接口
 Chatservice *Chatservice::instance()
 {
@@ -24,12 +33,31 @@ Chatservice::Chatservice()
     _msgHandlerMap.insert({ADD_GROUP_ACK, std::bind(&Chatservice::addGroup, this, _1, _2, _3)});
     _msgHandlerMap.insert({GROUP_CHAT_MSG, std::bind(&Chatservice::groupChat, this, _1, _2, _3)});
     _msgHandlerMap.insert({LOGINOUT_MSG, std::bind(&Chatservice::loginout, this, _1, _2, _3)});
+}
+
+// 启动业务
+void Chatservice::start(const string &serverId)
+{
+    // redis订阅线程启动后会读取_serverId，必须先设置
+    _serverId = serverId;
+
+    // 启动离线消息写入线程
+    _offlineMsgWriter.start();
 
     // 链接redis
     if (_redis.connect())
     {
         // 绑定回调
         _redis.init_notify_handler(std::bind(&Chatservice::handlerRedisSubscirbMsg, this, _1, _2));
+        _redis.init_channel_handler(std::bind(&Chatservice::handlerChannelMsg, this, _1, _2));
+        _redis.subscribe(kPresenceChannel);
+        _redis.subscribe(kGroupChannel);
+    }
+
+    // 先订阅状态通知再加载，加载期间发生的变化不会丢失
+    for (int id : _userModel.queryOnlineUsers())
+    {
+        _presence.setOnline(id, "");
     }
 }
 
@@ -49,81 +77,45 @@ void Chatservice::login(const TcpConnectionPtr &conn, json &js, Timestamp time)
             response["msgid"] = LOGIN_MSG_ACK;
             response["errno"] = 2;
             response["errmsg"] = "this account is using, input another!";
-            conn->send(response.dump());
+            sendMessage(conn, response.dump());
         }
         else
         {
             // 登录成功，记录用户连接信息
+            _onlineUsers.add(id, conn);
+            // 在连接会话上记录用户id，断开时直接定位
+            if (ChatSession *session = getChatSession(conn))
             {
-                lock_guard<mutex> lock(_connMutex);
-                _userConnMap.insert({id, conn});
+                session->userid = id;
             }
             // 登录成功，更新用户状态信息 state offline=>online
             user.setState("online");
             _userModel.updateState(user);
+            updatePresence(id, true);
 
             // id用户登录成功后，向redis订阅channel(id)
             _redis.subscribe(id);
 
-            json response;
-            response["msgid"] = LOGIN_MSG_ACK;
-            response["errno"] = 0;
-            response["id"] = user.getId();
-            response["name"] = user.getName();
-
-            // 查询该用户是否有离线消息
+            // 取出该用户还在写入队列中的离线消息，排在数据库中更早的消息之后，不等待整个队列落库
+            vector<string> pending = _offlineMsgWriter.takePending(id);
             vector<string> vec = _offlineMsgModel.query(id);
+            vec.insert(vec.end(), make_move_iterator(pending.begin()), make_move_iterator(pending.end()));
             if (!vec.empty())
             {
-                response["offlinemsg"] = vec;
                 // 读取该用户的离线消息后，把该用户的所有离线消息删除掉
                 _offlineMsgModel.remove(id);
             }
-
-            // 查询该用户的好友信息并返回
+            // 查询该用户的好友信息
             vector<User> friendvec = _friendModel.query(id);
-            if (!friendvec.empty())
-            {
-                vector<string> vec2;
-                for (User &user : friendvec)
-                {
-                    json js;
-                    js["id"] = user.getId();
-                    js["name"] = user.getName();
-                    js["state"] = user.getState();
-                    vec2.push_back(js.dump());
-                }
-                response["friends"] = vec2;
-            }
-
             // 查询用户的群组信息
             vector<Group> groupuserVec = _groupModel.queryGroups(id);
-            if (!groupuserVec.empty())
-            {
-                vector<string> groupvec;
-                for (Group &group : groupuserVec)
-                {
-                    json grpjs;
-                    grpjs["groupid"] = group.getId();
-                    grpjs["groupname"] = group.getName();
-                    grpjs["groupdesc"] = group.getDesc();
-                    vector<string> uservec;
-                    for (const GroupUser &groupuser : group.getGroupUsers())
-                    {
-                        json js;
-                        js["id"] = groupuser.getId();
-                        js["name"] = groupuser.getName();
-                        js["state"] = groupuser.getState();
-                        js["role"] = groupuser.getRole();
-                        uservec.push_back(js.dump());
-                    }
-                    grpjs["groupuser"] = uservec;
-                    groupvec.push_back(grpjs.dump());
-                }
-                response["groups"] = groupvec;
-            }
 
-            conn->send(response.dump());
+            // 新客户端在请求中带nested:true，好友和群组以原生数组返回；否则按旧格式把每个元素序列化成字符串
+            bool nested = js.contains("nested") && js["nested"].is_boolean() && js["nested"].get<bool>();
+            thread_local string response;
+            response.clear();
+            buildLoginResponse(response, user, vec, friendvec, groupuserVec, nested);
+            sendMessage(conn, response);
         }
     }
     else
@@ -133,7 +125,7 @@ void Chatservice::login(const TcpConnectionPtr &conn, json &js, Timestamp time)
         response["msgid"] = LOGIN_MSG_ACK;
         response["errno"] = 1;
         response["errmsg"] = "id or password is invalid!";
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
 }
 // 注册业务
@@ -153,7 +145,7 @@ void Chatservice::reg(const TcpConnectionPtr &conn, json &js, Timestamp time)
         response["msgid"] = REG_MSG_ACK;
         response["errno"] = 0;
         response["id"] = user.getId();
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
     else
     {
@@ -161,7 +153,7 @@ void Chatservice::reg(const TcpConnectionPtr &conn, json &js, Timestamp time)
         json response;
         response["msgid"] = REG_MSG_ACK;
         response["errno"] = 1;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
 }
 
@@ -169,13 +161,10 @@ void Chatservice::reg(const TcpConnectionPtr &conn, json &js, Timestamp time)
 void Chatservice::loginout(const TcpConnectionPtr &conn, json &js, Timestamp time)
 {
     int userid = js["id"].get<int>();
+    _onlineUsers.remove(userid);
+    if (ChatSession *session = getChatSession(conn))
     {
-        lock_guard<mutex> lock(_connMutex);
-        auto it = _userConnMap.find(userid);
-        if (it != _userConnMap.end())
-        {
-            _userConnMap.erase(it);
-        }
+        session->userid = -1;
     }
     // 取消redis订阅
     _redis.unsubscribe(userid);
@@ -183,33 +172,31 @@ void Chatservice::loginout(const TcpConnectionPtr &conn, json &js, Timestamp tim
     // 更新用户拽他
     User user(userid, "", "", "offline");
     _userModel.updateState(user);
+    updatePresence(userid, false);
 }
 
 // 一对一聊天业务
 void Chatservice::oneChat(const TcpConnectionPtr &conn, json &js, Timestamp time)
 {
     int toid = js["toid"].get<int>();
+    TcpConnectionPtr toConn = _onlineUsers.find(toid);
+    if (toConn)
     {
-        lock_guard<mutex> lock(_connMutex);
-        auto it = _userConnMap.find(toid);
-        if (it != _userConnMap.end())
-        {
-            // toid在线，转发消息   推回服务器
-            it->second->send(js.dump());
-            return;
-        }
+        // toid在线，转发消息   推回服务器
+        sendMessage(toConn, js.dump());
+        return;
     }
 
-    // 查询是否其他服务器
-    User user = _userModel.dbquery(toid);
-    if (user.getState() == "online")
+    // 查询是否在其他服务器，在本机登记但连接已断开的按离线处理
+    string server;
+    if (_presence.isOnline(toid, &server) && server != _serverId)
     {
         _redis.publish(toid, js.dump());
     }
     else
     {
         // toid不在线，存储离线消息
-        _offlineMsgModel.insert(toid, js.dump());
+        _offlineMsgWriter.append(toid, js.dump());
     }
 }
 
@@ -226,7 +213,7 @@ void Chatservice::addFriend(const TcpConnectionPtr &conn, json &js, Timestamp ti
         json response;
         response["msgid"] = ADD_FRIEND_ACK;
         response["errno"] = 0;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
     else
     {
@@ -234,7 +221,7 @@ void Chatservice::addFriend(const TcpConnectionPtr &conn, json &js, Timestamp ti
         json response;
         response["msgid"] = ADD_FRIEND_ACK;
         response["errno"] = 1;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
 }
 
@@ -253,11 +240,13 @@ void Chatservice::createGroup(const TcpConnectionPtr &conn, json &js, Timestamp
         // 成功
         //  存储群组创建人信息
         _groupModel.addGroup(userid, group.getId(), "creator");
+        _groupMembers.addMember(group.getId(), userid);
+        notifyGroupChanged(group.getId());
         json response;
         response["msgid"] = CREATE_GROUP_ACK;
         response["grouid"] = group.getId();
         response["errno"] = 0;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
     else
     {
@@ -265,7 +254,7 @@ void Chatservice::createGroup(const TcpConnectionPtr &conn, json &js, Timestamp
         json response;
         response["msgid"] = CREATE_GROUP_ACK;
         response["errno"] = 1;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
 }
 
@@ -278,11 +267,13 @@ void Chatservice::addGroup(const TcpConnectionPtr &conn, json &js, Timestamp tim
     bool state = _groupModel.addGroup(userid, groupid, "normal");
     if (state)
     {
+        _groupMembers.addMember(groupid, userid);
+        notifyGroupChanged(groupid);
         // 添加成功
         json response;
         response["msgid"] = ADD_GROUP_ACK;
         response["errno"] = 0;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
     else
     {
@@ -290,7 +281,7 @@ void Chatservice::addGroup(const TcpConnectionPtr &conn, json &js, Timestamp tim
         json response;
         response["msgid"] = ADD_GROUP_ACK;
         response["errno"] = 1;
-        conn->send(response.dump());
+        sendMessage(conn, response.dump());
     }
 }
 
@@ -299,32 +290,58 @@ void Chatservice::groupChat(const TcpConnectionPtr &conn, json &js, Timestamp ti
 {
     int userid = js["id"].get<int>();
     int groupid = js["groupid"].get<int>();
-    vector<int> useridVec = _groupModel.queryGroupUsers(userid, groupid);
+    // 从群成员缓存取成员，未命中时才查库
+    GroupMemberCache::MemberList members = _groupMembers.get(groupid, [this](int gid, vector<int> &ids)
+                                                             { return _groupModel.queryGroupMembers(gid, ids); });
+    if (!members)
+    {
+        LOG_ERROR << "load members of group " << groupid << " failed, group message from " << userid << " not delivered";
+        return;
+    }
+    vector<int> useridVec;
+    useridVec.reserve(members->size());
+    for (int id : *members)
+    {
+        if (id != userid)
+        {
+            useridVec.push_back(id);
+        }
+    }
+
+    // 批量取出在线成员的连接，锁外转发
+    vector<TcpConnectionPtr> connVec;
+    _onlineUsers.findBatch(useridVec, connVec);
 
+    string msg = js.dump();
+    vector<int> remoteVec;
+    for (size_t i = 0; i < useridVec.size(); ++i)
     {
-        lock_guard<mutex> lock(_connMutex);
-        for (int id : useridVec)
+        if (connVec[i])
         {
-            auto it = _userConnMap.find(id);
-            if (it != _userConnMap.end())
-            {
-                // 转发群消息
-                it->second->send(js.dump());
-            }
-            else
-            {
-                // 查询是否其他服务器
-                User user = _userModel.dbquery(id);
-                if (user.getState() == "online")
-                {
-                    _redis.publish(id, js.dump());
-                }
-                else
-                {
-                    //// 存储离线群消息
-                    _offlineMsgModel.insert(id, js.dump());
-                }
-            }
+            // 转发群消息
+            sendMessage(connVec[i], msg);
+        }
+        else
+        {
+            remoteVec.push_back(useridVec[i]);
+        }
+    }
+
+    // 不在本机的成员从状态缓存批量判断是否在其他服务器
+    vector<char> onlineVec;
+    vector<string> serverVec;
+    _presence.queryBatch(remoteVec, onlineVec, serverVec);
+    for (size_t i = 0; i < remoteVec.size(); ++i)
+    {
+        int id = remoteVec[i];
+        if (onlineVec[i] && serverVec[i] != _serverId)
+        {
+            _redis.publish(id, msg);
+        }
+        else
+        {
+            // 存储离线群消息，由写入线程合并成批量insert
+            _offlineMsgWriter.append(id, msg);
         }
     }
 }
@@ -332,34 +349,34 @@ void Chatservice::groupChat(const TcpConnectionPtr &conn, json &js, Timestamp ti
 // 客户端异常业务
 void Chatservice::clientCloseException(const TcpConnectionPtr &conn)
 {
-    User user;
+    // 通过连接会话直接取得用户id，无需遍历在线表
+    ChatSession *session = getChatSession(conn);
+    if (session == nullptr)
     {
-        lock_guard<mutex> lock(_connMutex);
-        for (auto it = _userConnMap.begin(); it != _userConnMap.end(); it++)
-        {
-            if (it->second == conn)
-            {
-                // 从map表删除用户的链接信息
-                user.setId(it->first);
-                _userConnMap.erase(it);
-                break;
-            }
-        }
+        return;
     }
+    int userid = session->userid.exchange(-1);
+    if (userid == -1) // 未登录的连接
+    {
+        return;
+    }
+
+    // 从在线表删除用户的链接信息
+    _onlineUsers.remove(userid, conn);
 
     // 取消redis订阅
-    _redis.unsubscribe(user.getId());
+    _redis.unsubscribe(userid);
 
-    if (user.getId() != -1) // 为有效用户
-    {
-        user.setState("offline");
-        _userModel.updateState(user);
-    }
+    User user(userid, "", "", "offline");
+    _userModel.updateState(user);
+    updatePresence(userid, false);
 }
 
 // 服务器异常，业务重置方法
 void Chatservice::reset()
 {
+    // 写完队列中的离线消息
+    _offlineMsgWriter.stop();
     // 把online状态的用户，设置成offline
     _userModel.resetState();
 }
@@ -384,14 +401,97 @@ MsgHandler Chatservice::getHandler(int msgid)
 // redis处理器
 void Chatservice::handlerRedisSubscirbMsg(int userid, string msg)
 {
-    lock_guard<mutex> lock(_connMutex);
-    auto it = _userConnMap.find(userid);
-    if (it != _userConnMap.end())
+    TcpConnectionPtr conn = _onlineUsers.find(userid);
+    if (conn)
     {
         // toid在线，转发消息   推回服务器
-        it->second->send(msg);
+        sendMessage(conn, msg);
         return;
     }
     // 存储该用户的离线消息
-    _offlineMsgModel.insert(userid, msg);
-}
\ No newline at end of file
+    _offlineMsgWriter.append(userid, msg);
+}
+
+// 更新本机状态缓存并通知其他服务器
+void Chatservice::updatePresence(int userid, bool online)
+{
+    if (online)
+    {
+        _presence.setOnline(userid, _serverId);
+    }
+    else
+    {
+        _presence.setOffline(userid, _serverId);
+    }
+    // 格式: online|offline userid serverid
+    ostringstream os;
+    os << (online ? "online " : "offline ") << userid << " " << _serverId;
+    _redis.publish(string(kPresenceChannel), os.str());
+}
+
+// redis命名通道上其他服务器的通知
+void Chatservice::handlerChannelMsg(string channel, string msg)
+{
+    if (channel == kPresenceChannel)
+    {
+        handlePresenceMsg(msg);
+    }
+    else if (channel == kGroupChannel)
+    {
+        // 格式: groupid serverid，本机的修改已直接更新缓存
+        istringstream is(msg);
+        int groupid = -1;
+        string server;
+        if ((is >> groupid >> server) && server == _serverId)
+        {
+            return;
+        }
+        _groupMembers.invalidate(groupid);
+    }
+}
+
+// 通知其他服务器群成员已变更
+void Chatservice::notifyGroupChanged(int groupid)
+{
+    _redis.publish(string(kGroupChannel), to_string(groupid) + " " + _serverId);
+}
+
+// 处理其他服务器的用户状态通知
+void Chatservice::handlePresenceMsg(const string &msg)
+{
+    istringstream is(msg);
+    string state, server;
+    int userid = -1;
+    if (!(is >> state >> userid))
+    {
+        LOG_ERROR << "invalid presence message: " << msg;
+        return;
+    }
+    is >> server;
+    // 本机发出的通知已在本地生效，忽略回环
+    if (server == _serverId)
+    {
+        return;
+    }
+    if (state == "online")
+    {
+        _presence.setOnline(userid, server);
+    }
+    else
+    {
+        _presence.setOffline(userid, server);
+    }
+}
+
+// 输出缓存与离线消息写入的运行指标
+void Chatservice::reportStats()
+{
+    OfflineMsgWriter::Stats writer = _offlineMsgWriter.stats();
+    LOG_INFO << "stats online:" << _onlineUsers.size()
+             << " presence:" << _presence.size()
+             << " groupCache:" << _groupMembers.size()
+             << " groupCacheHitRate:" << _groupMembers.hitRate()
+             << " offlineQueue:" << writer.queueDepth
+             << " offlineLastFlushUs:" << writer.lastFlushUs
+             << " offlineMaxFlushUs:" << writer.maxFlushUs;
+}
@@ -0,0 +1,118 @@
+#include "codec.hpp"
+#include <muduo/base/Logging.h>
+#include <cstring>
+
+MessageCodec::MessageCodec(FrameType type,
+                           const FrameCallback &cb,
+                           char delimiter,
+                           size_t maxFrameSize)
+    : _type(type), _frameCallback(cb), _delimiter(delimiter), _maxFrameSize(maxFrameSize)
+{
+}
+
+// 解出buffer中所有完整的帧
+void MessageCodec::onMessage(const TcpConnectionPtr &conn, Buffer *buffer, Timestamp time) const
+{
+    if (_type == LENGTH_HEADER)
+    {
+        while (buffer->readableBytes() >= kHeaderLen)
+        {
+            const int32_t len = buffer->peekInt32();
+            if (len < 0 || static_cast<size_t>(len) > _maxFrameSize)
+            {
+                LOG_ERROR << conn->name() << " invalid frame length " << len;
+                buffer->retrieveAll();
+                conn->shutdown();
+                return;
+            }
+            if (buffer->readableBytes() < kHeaderLen + len)
+            {
+                // 半包，等待后续数据
+                break;
+            }
+            buffer->retrieve(kHeaderLen);
+            string frame(buffer->peek(), len);
+            buffer->retrieve(len);
+            _frameCallback(conn, frame, time);
+        }
+        return;
+    }
+
+    while (buffer->readableBytes() > 0)
+    {
+        const char *begin = buffer->peek();
+        const char *end = static_cast<const char *>(memchr(begin, _delimiter, buffer->readableBytes()));
+        if (end == nullptr)
+        {
+            if (buffer->readableBytes() > _maxFrameSize)
+            {
+                LOG_ERROR << conn->name() << " frame exceeds " << _maxFrameSize << " bytes";
+                buffer->retrieveAll();
+                conn->shutdown();
+            }
+            // 半包，等待后续数据
+            return;
+        }
+
+        size_t len = end - begin;
+        // 一次收到的数据里已有分隔符时，同样限制单帧长度
+        if (len > _maxFrameSize)
+        {
+            LOG_ERROR << conn->name() << " invalid frame length " << len;
+            buffer->retrieveAll();
+            conn->shutdown();
+            return;
+        }
+        // 兼容 \r\n 结尾
+        if (len > 0 && begin[len - 1] == '\r')
+        {
+            --len;
+        }
+        string frame(begin, len);
+        buffer->retrieveUntil(end + 1);
+        if (frame.empty())
+        {
+            continue;
+        }
+        _frameCallback(conn, frame, time);
+    }
+}
+
+// 封装帧并发送
+void MessageCodec::send(const TcpConnectionPtr &conn, const string &msg) const
+{
+    Buffer buf;
+    buf.append(msg.data(), msg.size());
+    if (_type == LENGTH_HEADER)
+    {
+        buf.prependInt32(static_cast<int32_t>(msg.size()));
+    }
+    else
+    {
+        buf.append(&_delimiter, 1);
+    }
+    conn->send(&buf);
+}
+
+// 解析分帧方式
+bool MessageCodec::parseFrameType(const string &name, FrameType &type, char &delimiter)
+{
+    if (name == "len")
+    {
+        type = LENGTH_HEADER;
+        return true;
+    }
+    if (name == "line")
+    {
+        type = DELIMITER;
+        delimiter = '\n';
+        return true;
+    }
+    if (name == "nul")
+    {
+        type = DELIMITER;
+        delimiter = '\0';
+        return true;
+    }
+    return false;
+}
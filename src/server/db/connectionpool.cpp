@@ -16,6 +16,10 @@ Connection::Connection()
 
 Connection::~Connection()
 {
+    for (auto &stmt : _stmtCache)
+    {
+        mysql_stmt_close(stmt.second);
+    }
     if (_conn != nullptr)
         mysql_close(_conn);
 }
@@ -58,6 +62,31 @@ MYSQL_RES* Connection::query(const string& sql)
     return mysql_use_result(_conn);
 }
 
+// 获取预处理语句
+MYSQL_STMT* Connection::prepare(const string& sql)
+{
+    auto it = _stmtCache.find(sql);
+    if (it != _stmtCache.end())
+    {
+        return it->second;
+    }
+
+    MYSQL_STMT* stmt = mysql_stmt_init(_conn);
+    if (stmt == nullptr)
+    {
+        LOG_ERROR << "stmt init fail: " << mysql_error(_conn);
+        return nullptr;
+    }
+    if (mysql_stmt_prepare(stmt, sql.c_str(), sql.size()))
+    {
+        LOG_ERROR << "prepare fail: " << sql << " error: " << mysql_stmt_error(stmt);
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+    _stmtCache.insert({sql, stmt});
+    return stmt;
+}
+
 /*ConnectionPool类实现
 */
 // 连接池接口
@@ -0,0 +1,67 @@
+#include "jsonwriter.hpp"
+#include <cstring>
+
+// 对象的键
+void JsonWriter::key(const char *name)
+{
+    prefix();
+    escape(_out, name, strlen(name));
+    _out += ':';
+    _needComma = false;
+}
+
+void JsonWriter::value(int v)
+{
+    prefix();
+    _out += to_string(v);
+    _needComma = true;
+}
+
+void JsonWriter::value(const string &v)
+{
+    prefix();
+    escape(_out, v.data(), v.size());
+    _needComma = true;
+}
+
+void JsonWriter::value(const char *v)
+{
+    prefix();
+    escape(_out, v, strlen(v));
+    _needComma = true;
+}
+
+// 转义引号、反斜杠和控制字符，其余字节(包括UTF-8)原样追加
+void JsonWriter::escape(string &out, const char *data, size_t len)
+{
+    static const char kHex[] = "0123456789abcdef";
+    out += '"';
+    size_t begin = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        out.append(data + begin, i - begin);
+        begin = i + 1;
+        switch (c)
+        {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            out += "\\u00";
+            out += kHex[c >> 4];
+            out += kHex[c & 0xf];
+            break;
+        }
+    }
+    out.append(data + begin, len - begin);
+    out += '"';
+}
@@ -0,0 +1,139 @@
+#include "loginresponse.hpp"
+#include "jsonwriter.hpp"
+#include "public.hpp"
+
+// 好友信息
+static void writeFriend(JsonWriter &writer, const User &user)
+{
+    writer.startObject();
+    writer.key("id");
+    writer.value(user.getId());
+    writer.key("name");
+    writer.value(user.getName());
+    writer.key("state");
+    writer.value(user.getState());
+    writer.endObject();
+}
+
+// 群成员信息
+static void writeGroupUser(JsonWriter &writer, const GroupUser &user)
+{
+    writer.startObject();
+    writer.key("id");
+    writer.value(user.getId());
+    writer.key("name");
+    writer.value(user.getName());
+    writer.key("state");
+    writer.value(user.getState());
+    writer.key("role");
+    writer.value(user.getRole());
+    writer.endObject();
+}
+
+// 群组信息，nested为false时每个成员写成json字符串
+static void writeGroup(JsonWriter &writer, const Group &group, bool nested, string &scratch)
+{
+    writer.startObject();
+    writer.key("groupid");
+    writer.value(group.getId());
+    writer.key("groupname");
+    writer.value(group.getName());
+    writer.key("groupdesc");
+    writer.value(group.getDesc());
+    writer.key("groupuser");
+    writer.startArray();
+    for (const GroupUser &groupuser : group.getGroupUsers())
+    {
+        if (nested)
+        {
+            writeGroupUser(writer, groupuser);
+        }
+        else
+        {
+            scratch.clear();
+            JsonWriter inner(scratch);
+            writeGroupUser(inner, groupuser);
+            writer.value(scratch);
+        }
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+void buildLoginResponse(string &out,
+                        const User &user,
+                        const vector<string> &offlinemsg,
+                        const vector<User> &friends,
+                        const vector<Group> &groups,
+                        bool nested)
+{
+    // 兼容模式下元素先写入临时串再整体转义，线程内复用避免反复分配
+    thread_local string scratch;
+    thread_local string groupScratch;
+
+    JsonWriter writer(out);
+    writer.startObject();
+    writer.key("msgid");
+    writer.value(LOGIN_MSG_ACK);
+    writer.key("errno");
+    writer.value(0);
+    writer.key("id");
+    writer.value(user.getId());
+    writer.key("name");
+    writer.value(user.getName());
+
+    if (!offlinemsg.empty())
+    {
+        writer.key("offlinemsg");
+        writer.startArray();
+        for (const string &msg : offlinemsg)
+        {
+            writer.value(msg);
+        }
+        writer.endArray();
+    }
+
+    if (!friends.empty())
+    {
+        writer.key("friends");
+        writer.startArray();
+        for (const User &friendUser : friends)
+        {
+            if (nested)
+            {
+                writeFriend(writer, friendUser);
+            }
+            else
+            {
+                scratch.clear();
+                JsonWriter inner(scratch);
+                writeFriend(inner, friendUser);
+                writer.value(scratch);
+            }
+        }
+        writer.endArray();
+    }
+
+    if (!groups.empty())
+    {
+        writer.key("groups");
+        writer.startArray();
+        for (const Group &group : groups)
+        {
+            if (nested)
+            {
+                writeGroup(writer, group, true, scratch);
+            }
+            else
+            {
+                groupScratch.clear();
+                JsonWriter inner(groupScratch);
+                writeGroup(inner, group, false, scratch);
+                writer.value(groupScratch);
+            }
+        }
+        writer.endArray();
+    }
+
+    writer.endObject();
+}
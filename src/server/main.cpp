@@ -9,32 +9,61 @@ using namespace std;
 using namespace muduo;
 using namespace muduo::net;
 
-// 处理服务器ctrl+c结束后，重置user的状态信息
-void resetHandler(int)
+static EventLoop *g_loop = nullptr;
+
+// 处理服务器ctrl+c：信号处理函数中只让事件循环退出，重置user的状态信息在主线程完成
+void quitHandler(int)
 {
-    Chatservice::instance()->reset();
-    exit(0);
+    if (g_loop != nullptr)
+    {
+        g_loop->quit();
+    }
 }
 
 int main(int argc, char **argv)
 {
     if(argc < 3)
     {
-        cerr << "command invalid! example: ./ChatServer 127.0.0.1 6000" << endl;
+        cerr << "command invalid! example: ./ChatServer 127.0.0.1 6000 [len|line|nul] [workers]" << endl;
         exit(-1);
     }
 
     char *ip = argv[1];
     uint16_t port = atoi(argv[2]);
-    
-    signal(SIGINT, resetHandler);
 
+    // 分帧方式，默认按换行分隔
+    MessageCodec::FrameType frameType = MessageCodec::DELIMITER;
+    char delimiter = '\n';
+    if (argc > 3 && !MessageCodec::parseFrameType(argv[3], frameType, delimiter))
+    {
+        cerr << "invalid frame type: " << argv[3] << ", expect len|line|nul" << endl;
+        exit(-1);
+    }
+
+    // 业务线程数，0表示直接在IO线程处理
+    int workerNum = argc > 4 ? atoi(argv[4]) : 4;
+    if (workerNum < 0)
+    {
+        cerr << "invalid worker number: " << argv[4] << endl;
+        exit(-1);
+    }
+    
     EventLoop loop;
+    g_loop = &loop;
+    signal(SIGINT, quitHandler);
+
     InetAddress addr(ip, port);
-    ChatServer server(&loop, addr, "Chatserver");
+    {
+        ChatServer server(&loop, addr, "Chatserver", frameType, delimiter, workerNum);
+        server.start();
+        loop.loop();
+        // 退出循环后按以下顺序关闭，server离开作用域时完成前两步：
+        // 1. TcpServer关闭所有连接并等待IO线程退出，断开回调把清理任务提交给业务线程池
+        // 2. 业务线程池执行完已提交的任务后停止
+    }
 
-    server.start();
-    loop.loop();
+    // 3. 业务线程都已退出，写完队列中的离线消息，重置user的状态信息
+    Chatservice::instance()->reset();
 
     return 0;
 }
\ No newline at end of file
@@ -47,12 +47,15 @@ bool GroupModel::addGroup(int userid, int groupid, string role)
 
 
 // 查询用户所在群组信息  用户所在群及群内成员
+// 一次连接查询取回全部群组和成员，按群组id排序后顺序组装，避免每个群再查一次
 vector<Group> GroupModel::queryGroups(int userid)
 {
     char sql[1024] = {0};
-    // 根据Groupuser信息得到AllGroup中信息
-    sprintf(sql, "select a.id,a.groupname,a.groupdesc from AllGroup a inner join \
-         GroupUser b on a.id = b.groupid where b.userid=%d",
+    sprintf(sql, "select a.id,a.groupname,a.groupdesc,u.id,u.name,u.state,c.grouprole \
+        from GroupUser b inner join AllGroup a on a.id = b.groupid \
+        inner join GroupUser c on c.groupid = a.id \
+        inner join User u on u.id = c.userid \
+        where b.userid=%d order by a.id",
             userid);
 
     vector<Group> groupVec;
@@ -67,69 +70,67 @@ vector<Group> GroupModel::queryGroups(int userid)
     MYSQL_RES *res = conn->query(sql);
     if (res != nullptr)
     {
-        // 查出userid所有的群组信息
+        // 每行是一个(群组, 成员)，同一群组的行相邻
         MYSQL_ROW row;
         while ((row = mysql_fetch_row(res)) != nullptr)
         {
-            Group group;
-            group.setId(atoi(row[0]));
-            group.setName(row[1]);
-            group.setDesc(row[2]);
-            groupVec.push_back(group);
-        }
-        mysql_free_result(res);
-    }
-
-    // 查询群组的用户信息
-    for (Group &group : groupVec)
-    {
-        sprintf(sql, "select a.id,a.name,a.state,b.grouprole from User a \
-        inner join GroupUser b on b.userid = a.id where b.groupid=%d",
-                group.getId());
-
-        MYSQL_RES *res = conn->query(sql);
-        if (res != nullptr)
-        {
-            MYSQL_ROW row;
-            while ((row = mysql_fetch_row(res)) != nullptr)
+            int groupid = atoi(row[0]);
+            if (groupVec.empty() || groupVec.back().getId() != groupid)
             {
-                GroupUser groupuser;
-                groupuser.setId(atoi(row[0]));
-                groupuser.setName(row[1]);
-                groupuser.setState(row[2]);
-                groupuser.setRole(row[3]);
-                group.getGroupUsers().push_back(groupuser);
+                groupVec.emplace_back(groupid, row[1], row[2]);
             }
-            mysql_free_result(res);
+
+            GroupUser groupuser;
+            groupuser.setId(atoi(row[3]));
+            groupuser.setName(row[4]);
+            groupuser.setState(row[5]);
+            groupuser.setRole(row[6]);
+            groupVec.back().getGroupUsers().push_back(groupuser);
         }
+        mysql_free_result(res);
     }
     return groupVec;
 }
 
-// 给用户群聊业务给群组其它成员群发消息
-vector<int> GroupModel::queryGroupUsers(int userid, int groupid)
+// 查询群组全部成员id，没有连接或查询失败时返回false
+bool GroupModel::queryGroupMembers(int groupid, vector<int> &idVec)
 {
     char sql[1024] = {0};
-    sprintf(sql, "select userid from GroupUser where groupid = %d and userid != %d", groupid, userid);
+    sprintf(sql, "select userid from GroupUser where groupid = %d", groupid);
 
-    vector<int> idVec;
-    
     ConnectionPool* pool = ConnectionPool::getConnectionPool();
     ConnectionRAII conn(pool);
-    
+
     if (!conn.isValid()) {
-        return idVec;
+        return false;
     }
-    
+
     MYSQL_RES *res = conn->query(sql);
-    if (res != nullptr)
+    if (res == nullptr)
     {
-        MYSQL_ROW row;
-        while ((row = mysql_fetch_row(res)) != nullptr)
-        {
-            idVec.push_back(atoi(row[0]));
-        }
-        mysql_free_result(res);
+        return false;
+    }
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(res)) != nullptr)
+    {
+        idVec.push_back(atoi(row[0]));
+    }
+    mysql_free_result(res);
+    return true;
+}
+
+// 退出群组
+bool GroupModel::quitGroup(int userid, int groupid)
+{
+    char sql[1024] = {0};
+    sprintf(sql, "delete from GroupUser where groupid = %d and userid = %d", groupid, userid);
+
+    ConnectionPool* pool = ConnectionPool::getConnectionPool();
+    ConnectionRAII conn(pool);
+
+    if (!conn.isValid()) {
+        return false;
     }
-    return idVec;
-}
\ No newline at end of file
+
+    return conn->update(sql);
+}
@@ -1,56 +1,161 @@
 #include "offlinemsgmodel.hpp"
-#include "db.h"
+#include "connectionpool.h"
+#include <muduo/base/Logging.h>
 #include <vector>
 #include <string>
+#include <cstring>
 using namespace std;
 
 // 存储用户的离线消息
 bool OfflineMsgModel::insert(int userid, string msg)
 {
-    char sql[1024] = {0};
-    sprintf(sql, "insert into OfflineMessage values(%d, '%s')", userid, msg.c_str());
+    ConnectionPool* pool = ConnectionPool::getConnectionPool();
+    ConnectionRAII conn(pool);
 
-    MySQL database;
-    if (database.connect())
+    if (!conn.isValid()) {
+        return false;
+    }
+
+    MYSQL_STMT *stmt = conn->prepare("insert into OfflineMessage values(?, ?)");
+    if (stmt == nullptr) {
+        return false;
+    }
+
+    unsigned long msgLen = msg.size();
+    MYSQL_BIND params[2];
+    memset(params, 0, sizeof(params));
+    params[0].buffer_type = MYSQL_TYPE_LONG;
+    params[0].buffer = &userid;
+    params[1].buffer_type = MYSQL_TYPE_STRING;
+    params[1].buffer = const_cast<char *>(msg.data());
+    params[1].buffer_length = msgLen;
+    params[1].length = &msgLen;
+
+    if (mysql_stmt_bind_param(stmt, params) || mysql_stmt_execute(stmt))
+    {
+        LOG_ERROR << "insert offline message fail: " << mysql_stmt_error(stmt);
+        return false;
+    }
+    return true;
+}
+// 批量存储离线消息
+bool OfflineMsgModel::insert(const vector<pair<int, string>> &msgs)
+{
+    if (msgs.empty()) {
+        return true;
+    }
+
+    ConnectionPool* pool = ConnectionPool::getConnectionPool();
+    ConnectionRAII conn(pool);
+
+    if (!conn.isValid()) {
+        return false;
+    }
+
+    // 行数不固定，拼接为 insert ... values(...),(...) 并转义消息内容
+    MYSQL *mysql = conn->getMysqlConnection();
+    string sql = "insert into OfflineMessage values";
+    string escaped;
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        const string &msg = msgs[i].second;
+        escaped.resize(msg.size() * 2 + 1);
+        unsigned long len = mysql_real_escape_string(mysql, &escaped[0], msg.data(), msg.size());
+        if (i > 0) {
+            sql += ',';
+        }
+        sql += '(';
+        sql += to_string(msgs[i].first);
+        sql += ",'";
+        sql.append(escaped.data(), len);
+        sql += "')";
+    }
+
+    if (mysql_real_query(mysql, sql.data(), sql.size()))
     {
-        return database.update(sql);
+        LOG_ERROR << "insert " << msgs.size() << " offline messages fail: " << mysql_error(mysql);
+        return false;
     }
-    return false;
+    return true;
 }
 // 删除用户的离线消息
 bool OfflineMsgModel::remove(int userid)
 {
-    char sql[1024] = {0};
-    sprintf(sql, "delete from OfflineMessage where userid=%d", userid);
-    MySQL database;
-    if (database.connect())
+    ConnectionPool* pool = ConnectionPool::getConnectionPool();
+    ConnectionRAII conn(pool);
+
+    if (!conn.isValid()) {
+        return false;
+    }
+
+    MYSQL_STMT *stmt = conn->prepare("delete from OfflineMessage where userid=?");
+    if (stmt == nullptr) {
+        return false;
+    }
+
+    MYSQL_BIND param;
+    memset(&param, 0, sizeof(param));
+    param.buffer_type = MYSQL_TYPE_LONG;
+    param.buffer = &userid;
+
+    if (mysql_stmt_bind_param(stmt, &param) || mysql_stmt_execute(stmt))
     {
-        return database.update(sql);
+        LOG_ERROR << "remove offline message fail: " << mysql_stmt_error(stmt);
+        return false;
     }
-    return false;
+    return true;
 }
 // 查询用户的离线消息
 vector<string> OfflineMsgModel::query(int userid)
 {
-    char sql[1024] = {0};
-    sprintf(sql, "select message from OfflineMessage where userid = %d", userid);
-
     vector<string> vec;
-    MySQL database;
-    if (database.connect())
+    ConnectionPool* pool = ConnectionPool::getConnectionPool();
+    ConnectionRAII conn(pool);
+
+    if (!conn.isValid()) {
+        return vec;
+    }
+
+    MYSQL_STMT *stmt = conn->prepare("select message from OfflineMessage where userid = ?");
+    if (stmt == nullptr) {
+        return vec;
+    }
+
+    MYSQL_BIND param;
+    memset(&param, 0, sizeof(param));
+    param.buffer_type = MYSQL_TYPE_LONG;
+    param.buffer = &userid;
+
+    if (mysql_stmt_bind_param(stmt, &param) || mysql_stmt_execute(stmt))
     {
-        MYSQL_RES *res = database.query(sql);
-        if (res != nullptr)
+        LOG_ERROR << "query offline message fail: " << mysql_stmt_error(stmt);
+        return vec;
+    }
+
+    // 结果长度不定，先取长度再按长度取列
+    unsigned long msgLen = 0;
+    MYSQL_BIND result;
+    memset(&result, 0, sizeof(result));
+    result.buffer_type = MYSQL_TYPE_STRING;
+    result.length = &msgLen;
+    mysql_stmt_bind_result(stmt, &result);
+
+    // 把userid用户的所有离线消息放入vec中返回
+    int ret;
+    while ((ret = mysql_stmt_fetch(stmt)) == 0 || ret == MYSQL_DATA_TRUNCATED)
+    {
+        string msg(msgLen, '\0');
+        if (msgLen > 0)
         {
-            // 把userid用户的所有离线消息放入vec中返回
-            MYSQL_ROW row;
-            while ((row = mysql_fetch_row(res)) != nullptr)
-            {
-                vec.push_back(row[0]);
-            }
-            mysql_free_result(res);
-            return vec;
+            MYSQL_BIND column;
+            memset(&column, 0, sizeof(column));
+            column.buffer_type = MYSQL_TYPE_STRING;
+            column.buffer = &msg[0];
+            column.buffer_length = msgLen;
+            mysql_stmt_fetch_column(stmt, &column, 0, 0);
         }
+        vec.push_back(std::move(msg));
     }
+    mysql_stmt_free_result(stmt);
     return vec;
-}
\ No newline at end of file
+}
@@ -0,0 +1,235 @@
+#include "offlinemsgwriter.hpp"
+#include <muduo/base/Logging.h>
+#include <chrono>
+
+using namespace chrono;
+
+OfflineMsgWriter::OfflineMsgWriter(size_t batchSize,
+                                   int flushIntervalMs,
+                                   size_t maxQueueSize,
+                                   size_t maxBatchBytes)
+    : _batchSize(batchSize), _flushIntervalMs(flushIntervalMs),
+      _maxQueueSize(maxQueueSize), _maxBatchBytes(maxBatchBytes),
+      _running(false), _enqueueSeq(0),
+      _written(0), _failed(0), _flushes(0), _blocked(0),
+      _lastFlushUs(0), _maxFlushUs(0), _totalFlushUs(0)
+{
+}
+
+OfflineMsgWriter::~OfflineMsgWriter()
+{
+    stop();
+}
+
+// 启动后台写入线程
+void OfflineMsgWriter::start()
+{
+    lock_guard<mutex> lock(_mutex);
+    if (_running)
+    {
+        return;
+    }
+    _running = true;
+    _thread = thread(&OfflineMsgWriter::writeTask, this);
+}
+
+// 停止并写完剩余消息
+void OfflineMsgWriter::stop()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        if (!_running)
+        {
+            return;
+        }
+        _running = false;
+    }
+    _notEmpty.notify_all();
+    _notFull.notify_all();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+
+    Stats s = stats();
+    LOG_INFO << "offline message writer stopped, written:" << s.written << " failed:" << s.failed
+             << " flushes:" << s.flushes << " blocked:" << s.blocked << " maxFlushUs:" << s.maxFlushUs;
+}
+
+// 提交一条离线消息
+void OfflineMsgWriter::append(int userid, const string &msg)
+{
+    unique_lock<mutex> lock(_mutex);
+    if (_running && _queue.size() >= _maxQueueSize)
+    {
+        // 队列已满，阻塞业务线程直到后台线程腾出空位
+        ++_blocked;
+        _notFull.wait(lock, [this]()
+                      { return _queue.size() < _maxQueueSize || !_running; });
+    }
+    if (!_running)
+    {
+        // 未启动或已停止，直接同步写入
+        lock.unlock();
+        if (_model.insert(userid, msg))
+        {
+            ++_written;
+        }
+        else
+        {
+            ++_failed;
+        }
+        return;
+    }
+
+    _queue.emplace_back(userid, msg);
+    ++_queuedPerUser[userid];
+    ++_enqueueSeq;
+    if (_queue.size() >= _batchSize)
+    {
+        _notEmpty.notify_one();
+    }
+}
+
+// 取出该用户仍在队列中的消息
+vector<string> OfflineMsgWriter::takePending(int userid)
+{
+    vector<string> msgs;
+    unique_lock<mutex> lock(_mutex);
+    auto it = _queuedPerUser.find(userid);
+    if (it != _queuedPerUser.end())
+    {
+        // 原地压缩队列，其他用户的消息保持原有顺序
+        msgs.reserve(it->second);
+        auto out = _queue.begin();
+        for (auto in = _queue.begin(); in != _queue.end(); ++in)
+        {
+            if (in->first == userid)
+            {
+                msgs.push_back(std::move(in->second));
+            }
+            else
+            {
+                if (out != in)
+                {
+                    *out = std::move(*in);
+                }
+                ++out;
+            }
+        }
+        _queue.erase(out, _queue.end());
+        _queuedPerUser.erase(it);
+        _notFull.notify_all();
+    }
+    // 最多等待后台线程当前这一批
+    _flushed.wait(lock, [this, userid]()
+                  { return _inflightPerUser.count(userid) == 0; });
+    return msgs;
+}
+
+OfflineMsgWriter::Stats OfflineMsgWriter::stats() const
+{
+    Stats s;
+    {
+        lock_guard<mutex> lock(_mutex);
+        s.queueDepth = _queue.size();
+        s.appended = _enqueueSeq;
+    }
+    s.written = _written;
+    s.failed = _failed;
+    s.flushes = _flushes;
+    s.blocked = _blocked;
+    s.lastFlushUs = _lastFlushUs;
+    s.maxFlushUs = _maxFlushUs;
+    s.totalFlushUs = _totalFlushUs;
+    return s;
+}
+
+// 后台写入线程
+void OfflineMsgWriter::writeTask()
+{
+    vector<pair<int, string>> batch;
+    batch.reserve(_batchSize);
+
+    unique_lock<mutex> lock(_mutex);
+    while (true)
+    {
+        // 攒够一批或停止时立即写入，否则最多等待一个时间间隔
+        _notEmpty.wait_for(lock, milliseconds(_flushIntervalMs), [this]()
+                           { return _queue.size() >= _batchSize || !_running; });
+        if (_queue.empty())
+        {
+            if (!_running)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // 按条数和字节数取出一批，避免单条sql超过max_allowed_packet
+        size_t bytes = 0;
+        while (!_queue.empty() && batch.size() < _batchSize)
+        {
+            size_t len = _queue.front().second.size();
+            if (!batch.empty() && bytes + len > _maxBatchBytes)
+            {
+                break;
+            }
+            bytes += len;
+            int userid = _queue.front().first;
+            auto queued = _queuedPerUser.find(userid);
+            if (--queued->second == 0)
+            {
+                _queuedPerUser.erase(queued);
+            }
+            ++_inflightPerUser[userid];
+            batch.push_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+        _notFull.notify_all();
+
+        lock.unlock();
+        writeBatch(batch);
+        lock.lock();
+
+        _inflightPerUser.clear();
+        batch.clear();
+        _flushed.notify_all();
+    }
+}
+
+// 写入一批消息
+void OfflineMsgWriter::writeBatch(vector<pair<int, string>> &batch)
+{
+    auto begin = steady_clock::now();
+    if (_model.insert(batch))
+    {
+        _written += batch.size();
+    }
+    else
+    {
+        // 批量写入失败时逐条重试，避免一条坏数据拖累整批
+        for (auto &item : batch)
+        {
+            if (_model.insert(item.first, item.second))
+            {
+                ++_written;
+            }
+            else
+            {
+                ++_failed;
+                LOG_ERROR << "drop offline message for user " << item.first;
+            }
+        }
+    }
+
+    uint64_t us = duration_cast<microseconds>(steady_clock::now() - begin).count();
+    ++_flushes;
+    _lastFlushUs = us;
+    _totalFlushUs += us;
+    // 只有后台线程更新，直接比较即可
+    if (us > _maxFlushUs)
+    {
+        _maxFlushUs = us;
+    }
+}
@@ -90,4 +90,28 @@ void UserModel::resetState()
     if (conn.isValid()) {
         conn->update(sql);
     }
-}
\ No newline at end of file
+}
+
+// 查询所有在线用户的id
+vector<int> UserModel::queryOnlineUsers()
+{
+    vector<int> ids;
+    ConnectionPool* pool = ConnectionPool::getConnectionPool();
+    ConnectionRAII conn(pool);
+
+    if (!conn.isValid()) {
+        return ids;
+    }
+
+    MYSQL_RES *res = conn->query("select id from user1 where state = 'online'");
+    if (res != nullptr)
+    {
+        MYSQL_ROW row;
+        while ((row = mysql_fetch_row(res)) != nullptr)
+        {
+            ids.push_back(atoi(row[0]));
+        }
+        mysql_free_result(res);
+    }
+    return ids;
+}
@@ -1,5 +1,6 @@
 #include "redis.hpp"
 #include <iostream>
+#include <cctype>
 using namespace std;
 
 Redis::Redis()
@@ -52,6 +53,7 @@ bool Redis::connect()
 // 向redis指定的通道channel发布消息
 bool Redis::publish(int channel, string message)
 {
+    lock_guard<mutex> lock(_publish_mutex);
     redisReply *reply = (redisReply *)redisCommand(_publish_context, "PUBLISH %d %s", channel, message.c_str());
     if (nullptr == reply)
     {
@@ -62,9 +64,25 @@ bool Redis::publish(int channel, string message)
     return true;
 }
 
+// 向命名通道发布消息
+bool Redis::publish(const string &channel, const string &message)
+{
+    lock_guard<mutex> lock(_publish_mutex);
+    redisReply *reply = (redisReply *)redisCommand(_publish_context, "PUBLISH %s %b",
+                                                   channel.c_str(), message.data(), message.size());
+    if (nullptr == reply)
+    {
+        cerr << "publish command failed!" << endl;
+        return false;
+    }
+    freeReplyObject(reply);
+    return true;
+}
+
 // 向redis指定的通道subscribe订阅消息
 bool Redis::subscribe(int channel)
 {
+    lock_guard<mutex> lock(_subscribe_mutex);
     if (REDIS_ERR == redisAppendCommand(this->_subscribe_context, "SUBSCRIBE %d", channel))
     {
         cerr << "subscribe command failed!" << endl;
@@ -82,9 +100,31 @@ bool Redis::subscribe(int channel)
     }
     return true;
 }
+// 订阅命名通道
+bool Redis::subscribe(const string &channel)
+{
+    lock_guard<mutex> lock(_subscribe_mutex);
+    if (REDIS_ERR == redisAppendCommand(this->_subscribe_context, "SUBSCRIBE %s", channel.c_str()))
+    {
+        cerr << "subscribe command failed!" << endl;
+        return false;
+    }
+    int done = 0;
+    while (!done)
+    {
+        if (REDIS_ERR == redisBufferWrite(this->_subscribe_context, &done))
+        {
+            cerr << "subscribe command failed!" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
 // 向redis指定的通道unsubscribe取消订阅消息
 bool Redis::unsubscribe(int channel)
 {
+    lock_guard<mutex> lock(_subscribe_mutex);
     if (REDIS_ERR == redisAppendCommand(this->_subscribe_context, "UNSUBSCRIBE %d", channel))
     {
         cerr << "unsubscribe command failed!" << endl;
@@ -111,8 +151,17 @@ void Redis::observer_channel_message()
         // 订阅收到的消息是一个带三元素的数组
         if (reply != nullptr && reply->element[2] != nullptr && reply->element[2]->str != nullptr)
         {
-            // 给业务层上报通道上发生的消息
-            _notify_message_handler(atoi(reply->element[1]->str) , reply->element[2]->str);
+            const char *channel = reply->element[1]->str;
+            if (isdigit(static_cast<unsigned char>(channel[0])) || channel[0] == '-')
+            {
+                // 给业务层上报通道上发生的消息
+                _notify_message_handler(atoi(channel), reply->element[2]->str);
+            }
+            else if (_channel_message_handler)
+            {
+                // 命名通道的消息
+                _channel_message_handler(channel, string(reply->element[2]->str, reply->element[2]->len));
+            }
         }
         freeReplyObject(reply);
     }
@@ -122,4 +171,9 @@ void Redis::observer_channel_message()
 void Redis::init_notify_handler(function<void(int,string)> fn)
 {
     this->_notify_message_handler = fn;
-}
\ No newline at end of file
+}
+
+void Redis::init_channel_handler(function<void(string, string)> fn)
+{
+    this->_channel_message_handler = fn;
+}
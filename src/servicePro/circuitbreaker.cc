@@ -1,16 +1,17 @@
 // src/servicePro/circuitbreaker.cc
 #include "circuitbreaker.h"
+#include <muduo/base/Logging.h>
 
-CircuitBreaker::CircuitBreaker(int failureThreshold, 
-                               int timeoutMs, 
+CircuitBreaker::CircuitBreaker(int failureThreshold,
+                               int timeoutMs,
                                int halfOpenRetryCount)
     : failureThreshold_(failureThreshold)
     , timeoutMs_(timeoutMs)
     , maxHalfOpenRetryCount_(halfOpenRetryCount)
     , state_(CircuitState::CLOSED)
     , failureCount_(0)
+    , lastFailureMs_(NowMs())
     , successCount_(0)
-    , lastFailureTime_(std::chrono::steady_clock::now())
     , halfOpenRetryCount_(0)
 {
     LOG_INFO << "CircuitBreaker created with failureThreshold=" << failureThreshold
@@ -19,77 +20,112 @@ CircuitBreaker::CircuitBreaker(int failureThreshold,
 
 bool CircuitBreaker::CanPass()
 {
+    CircuitState state = state_.load();
+    if (state == CircuitState::CLOSED) {
+        return true;
+    }
+    // 超时时间未到，不加锁直接拒绝
+    if (state == CircuitState::OPEN && NowMs() - lastFailureMs_.load() < timeoutMs_) {
+        LOG_DEBUG << "Circuit breaker is OPEN, request rejected";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
     switch (state_.load()) {
         case CircuitState::CLOSED:
             return true;
-            
+
         case CircuitState::OPEN:
-            {
-                auto now = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now - lastFailureTime_).count();
-                
-                // 如果超时时间已到，进入半开状态
-                if (elapsed >= timeoutMs_) {
-                    state_ = CircuitState::HALF_OPEN;
-                    halfOpenRetryCount_ = 0;
-                    LOG_INFO << "Circuit breaker state changed to HALF_OPEN";
-                    return true;
-                }
-                
-                LOG_DEBUG << "Circuit breaker is OPEN, request rejected";
+            // 加锁后重新检查，其他线程可能已经完成切换后又重新打开
+            if (NowMs() - lastFailureMs_.load() < timeoutMs_) {
                 return false;
             }
-            
+            // 先重置半开计数再发布状态，看到HALF_OPEN的线程都在锁内计数
+            successCount_ = 0;
+            halfOpenRetryCount_ = 1;
+            halfOpenSince_ = std::chrono::steady_clock::now();
+            state_ = CircuitState::HALF_OPEN;
+            LOG_INFO << "Circuit breaker state changed to HALF_OPEN";
+            return true;
+
         case CircuitState::HALF_OPEN:
             // 在半开状态下，限制尝试次数
-            if (halfOpenRetryCount_.load() < maxHalfOpenRetryCount_) {
-                halfOpenRetryCount_++;
+            if (halfOpenRetryCount_ < maxHalfOpenRetryCount_) {
+                ++halfOpenRetryCount_;
+                return true;
+            }
+            // 名额用完且本轮超时仍未有结论，重新试探；上一轮的试探结果按start忽略
+            if (std::chrono::steady_clock::now() - halfOpenSince_ >= std::chrono::milliseconds(timeoutMs_)) {
+                successCount_ = 0;
+                halfOpenRetryCount_ = 1;
+                halfOpenSince_ = std::chrono::steady_clock::now();
+                LOG_INFO << "Circuit breaker HALF_OPEN probes timed out, probing again";
                 return true;
             }
             return false;
-            
+
         default:
             return false;
     }
 }
 
-void CircuitBreaker::OnSuccess()
+void CircuitBreaker::OnSuccess(std::chrono::steady_clock::time_point start)
 {
-    successCount_++;
-    
-    if (state_.load() == CircuitState::HALF_OPEN) {
-        // 在半开状态下，如果成功次数达到阈值，则关闭熔断器
-        if (successCount_.load() >= maxHalfOpenRetryCount_) {
-            state_ = CircuitState::CLOSED;
-            ResetStats();
-            LOG_INFO << "Circuit breaker state changed to CLOSED";
-        }
+    if (state_.load() == CircuitState::CLOSED) {
+        // 只统计连续失败
+        failureCount_ = 0;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 打开之前或上一轮半开时发出的请求不算试探成功
+    if (state_.load() != CircuitState::HALF_OPEN || start < halfOpenSince_) {
+        return;
+    }
+    // 在半开状态下，如果成功次数达到阈值，则关闭熔断器
+    if (++successCount_ >= maxHalfOpenRetryCount_) {
+        ResetStats();
+        state_ = CircuitState::CLOSED;
+        LOG_INFO << "Circuit breaker state changed to CLOSED";
     }
 }
 
-void CircuitBreaker::OnFailure()
+void CircuitBreaker::OnFailure(std::chrono::steady_clock::time_point start)
 {
-    failureCount_++;
-    lastFailureTime_ = std::chrono::steady_clock::now();
-    
-    switch (state_.load()) {
-        case CircuitState::CLOSED:
-            // 如果失败次数达到阈值，则打开熔断器
-            if (failureCount_.load() >= failureThreshold_) {
-                state_ = CircuitState::OPEN;
+    CircuitState state = state_.load();
+    if (state == CircuitState::CLOSED) {
+        lastFailureMs_ = NowMs();
+        // 如果连续失败次数达到阈值，则打开熔断器
+        if (failureCount_.fetch_add(1) + 1 >= failureThreshold_) {
+            CircuitState expected = CircuitState::CLOSED;
+            if (state_.compare_exchange_strong(expected, CircuitState::OPEN)) {
                 LOG_INFO << "Circuit breaker state changed to OPEN";
             }
-            break;
-            
-        case CircuitState::HALF_OPEN:
-            // 在半开状态下，如果失败，则重新打开熔断器
-            state_ = CircuitState::OPEN;
-            LOG_INFO << "Circuit breaker state changed to OPEN from HALF_OPEN";
-            break;
-            
-        default:
-            break;
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_.load() == CircuitState::OPEN) {
+        lastFailureMs_ = NowMs();
+        return;
+    }
+    // 在半开状态下，试探请求失败则重新打开熔断器；半开之前发出的请求超时不影响本轮试探
+    if (state_.load() == CircuitState::HALF_OPEN && start >= halfOpenSince_) {
+        lastFailureMs_ = NowMs();
+        state_ = CircuitState::OPEN;
+        LOG_INFO << "Circuit breaker state changed to OPEN from HALF_OPEN";
+    }
+}
+
+void CircuitBreaker::Release()
+{
+    if (state_.load() == CircuitState::CLOSED) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_.load() == CircuitState::HALF_OPEN && halfOpenRetryCount_ > 0) {
+        --halfOpenRetryCount_;
     }
 }
 
@@ -98,4 +134,10 @@ void CircuitBreaker::ResetStats()
     failureCount_ = 0;
     successCount_ = 0;
     halfOpenRetryCount_ = 0;
-}
\ No newline at end of file
+}
+
+int64_t CircuitBreaker::NowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
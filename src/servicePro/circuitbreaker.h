@@ -3,7 +3,8 @@
 
 #include <chrono>
 #include <atomic>
-#include <muduo/base/Logging.h>
+#include <cstdint>
+#include <mutex>
 
 // 熔断器状态
 enum class CircuitState {
@@ -13,6 +14,9 @@ enum class CircuitState {
 };
 
 // 熔断器
+// 连续失败达到阈值后打开，超时后半开放行少量试探请求，试探全部成功则关闭，任一失败重新打开
+// 试探名额用完后超过timeoutMs仍未关闭(试探结果丢失或迟迟不返回)，开始新一轮试探
+// 各方法可被多个线程同时调用；关闭状态下不加锁，打开转半开以及半开状态下的计数由mutex_保护
 class CircuitBreaker
 {
 public:
@@ -23,20 +27,23 @@ public:
     // 检查是否允许请求通过
     bool CanPass();
     
-    // 记录请求成功
-    void OnSuccess();
+    // 记录请求成功，start为请求开始时间；半开之前发出的请求不计入试探结果，不传时按试探请求计
+    void OnSuccess(std::chrono::steady_clock::time_point start = std::chrono::steady_clock::time_point::max());
     
-    // 记录请求失败
-    void OnFailure();
+    // 记录请求失败，start含义同上
+    void OnFailure(std::chrono::steady_clock::time_point start = std::chrono::steady_clock::time_point::max());
+
+    // CanPass放行后请求没有发出(如序列化失败)时调用，归还半开状态下占用的试探名额
+    void Release();
     
     // 获取当前状态
     CircuitState GetState() const { return state_; }
     
 private:
-    // 更新状态
-    void UpdateState();
+    // 当前时间(steady_clock毫秒)
+    static int64_t NowMs();
     
-    // 重置统计信息
+    // 重置统计信息，调用方持有mutex_
     void ResetStats();
     
     // 熔断阈值
@@ -51,15 +58,21 @@ private:
     // 当前状态
     std::atomic<CircuitState> state_;
     
-    // 失败计数
+    // 连续失败计数
     std::atomic<int> failureCount_;
     
-    // 成功计数
-    std::atomic<int> successCount_;
+    // 最后一次失败时间(steady_clock毫秒)
+    std::atomic<int64_t> lastFailureMs_;
+    
+    // 串行化离开OPEN/HALF_OPEN的状态切换，保护以下半开状态的数据
+    std::mutex mutex_;
     
-    // 最后一次失败时间
-    std::chrono::steady_clock::time_point lastFailureTime_;
+    // 半开状态下的成功计数
+    int successCount_;
     
     // 半开状态下的尝试次数
-    std::atomic<int> halfOpenRetryCount_;
+    int halfOpenRetryCount_;
+    
+    // 本轮试探开始的时间
+    std::chrono::steady_clock::time_point halfOpenSince_;
 };
\ No newline at end of file
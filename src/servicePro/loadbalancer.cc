@@ -1,5 +1,6 @@
 // src/servicePro/loadbalancer.cc
 #include "loadbalancer.h"
+#include <muduo/base/Logging.h>
 #include <functional>
 #include <algorithm>
 #include <atomic>
@@ -65,11 +66,18 @@ std::string ConsistentHashLoadBalancer::SelectNode(int userId)
 
 uint32_t ConsistentHashLoadBalancer::Hash(const std::string& key)
 {
-    // 简单的哈希函数实现
-    uint32_t hash = 0;
+    // FNV-1a，再做一次混合：用户id这类短键的哈希值也能分散到整个环上，
+    // 否则都落在环的起始段，集中到少数节点
+    uint32_t hash = 2166136261u;
     for (char c : key) {
-        hash = hash * 31 + c;
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
     }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
     return hash;
 }
 
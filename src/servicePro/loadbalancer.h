@@ -7,9 +7,10 @@
 #include <map>
 #include <memory>
 #include <atomic>
-#include <muduo/base/Logging.h>
+#include <cstdint>
 
 // 负载均衡器基类
+// 节点由AddNode/RemoveNode维护；节点不再变化后SelectNode可以被多个线程同时调用
 class LoadBalancer
 {
 public:
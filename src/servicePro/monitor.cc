@@ -1,120 +1,221 @@
 // src/servicePro/monitor.cc
 #include "monitor.h"
+#include <muduo/base/Logging.h>
+#include <algorithm>
 #include <sstream>
 
 ServiceMonitor::ServiceMonitor(const std::string& serviceName)
     : serviceName_(serviceName)
-    , totalRequests_(0)
-    , successfulRequests_(0)
-    , failedRequests_(0)
-    , totalLatency_(0)
-    , maxLatency_(0)
-    , minLatency_(UINT64_MAX)
+    , methodCount_(0)
 {
+    for (int i = 0; i < kMaxMethods; ++i) {
+        methods_[i].store(nullptr, std::memory_order_relaxed);
+    }
     LOG_INFO << "ServiceMonitor created for " << serviceName;
 }
 
-void ServiceMonitor::RecordRequest(const std::string& method, bool success, int64_t latencyMs)
+ServiceMonitor::~ServiceMonitor()
+{
+    int count = methodCount_.load();
+    for (int i = 0; i < count; ++i) {
+        delete methods_[i].load();
+    }
+}
+
+int ServiceMonitor::ShardIndex(bool& exclusive)
 {
-    totalRequests_++;
-    totalLatency_ += latencyMs;
-    
-    // 更新最大和最小延迟
-    if (latencyMs > static_cast<int64_t>(maxLatency_.load())) {
-        maxLatency_ = latencyMs;
-    }
-    if (latencyMs < static_cast<int64_t>(minLatency_.load()) && latencyMs > 0) {
-        minLatency_ = latencyMs;
-    }
-    
-    // 方法级别的统计
-    methodRequests_[method]++;
-    methodLatency_[method] += latencyMs;
-    
-    if (success) {
-        successfulRequests_++;
-        methodSuccess_[method]++;
+    // 线程首次记录时按顺序分配分片，分片不回收，超出的线程共用最后一片
+    static std::atomic<int> nextShard(0);
+    thread_local int shard = std::min(nextShard.fetch_add(1, std::memory_order_relaxed), kShards - 1);
+    exclusive = shard < kShards - 1;
+    return shard;
+}
+
+void ServiceMonitor::Add(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive)
+{
+    if (exclusive) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
     } else {
-        failedRequests_++;
-        methodFailures_[method]++;
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+void ServiceMonitor::UpdateMax(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive)
+{
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    if (exclusive) {
+        if (value > current) {
+            counter.store(value, std::memory_order_relaxed);
+        }
+        return;
+    }
+    // 共用的分片并发更新时用CAS保证不被较小的值覆盖
+    while (value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
     }
 }
 
+void ServiceMonitor::UpdateMin(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive)
+{
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    if (exclusive) {
+        if (value < current) {
+            counter.store(value, std::memory_order_relaxed);
+        }
+        return;
+    }
+    while (value < current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+ServiceMonitor::MethodId ServiceMonitor::RegisterMethod(const std::string& method)
+{
+    std::lock_guard<std::mutex> lock(registerMutex_);
+    auto it = methodIds_.find(method);
+    if (it != methodIds_.end()) {
+        return it->second;
+    }
+    int id = methodCount_.load(std::memory_order_relaxed);
+    if (id >= kMaxMethods) {
+        LOG_ERROR << "ServiceMonitor " << serviceName_ << " too many methods, ignore " << method;
+        return kInvalidMethod;
+    }
+    // 先放入方法再增加计数，GetStats读到计数时对应的方法已可见
+    methods_[id].store(new Method(method), std::memory_order_release);
+    methodCount_.store(id + 1, std::memory_order_release);
+    methodIds_[method] = id;
+    return id;
+}
+
+void ServiceMonitor::RecordRequest(MethodId method, bool success, int64_t latencyMs)
+{
+    if (method < 0 || method >= methodCount_.load(std::memory_order_acquire)) {
+        return;
+    }
+    bool exclusive;
+    Counters& counters = methods_[method].load(std::memory_order_acquire)->shards[ShardIndex(exclusive)];
+    uint64_t latency = latencyMs > 0 ? static_cast<uint64_t>(latencyMs) : 0;
+
+    // 请求数为成功数与失败数之和，读取时计算
+    Add(success ? counters.success : counters.failures, 1, exclusive);
+    Add(counters.latency, latency, exclusive);
+    UpdateMax(counters.maxLatency, latency, exclusive);
+    if (latency > 0) {
+        UpdateMin(counters.minLatency, latency, exclusive);
+    }
+}
+
+void ServiceMonitor::RecordRequest(const std::string& method, bool success, int64_t latencyMs)
+{
+    RecordRequest(RegisterMethod(method), success, latencyMs);
+}
+
 void ServiceMonitor::RecordError(const std::string& method, const std::string& errorType)
 {
-    errorCounts_[errorType]++;
-    LOG_ERROR << "Service " << serviceName_ << " method " << method 
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        errorCounts_[errorType]++;
+    }
+    LOG_ERROR << "Service " << serviceName_ << " method " << method
               << " encountered error: " << errorType;
 }
 
+void ServiceMonitor::RegisterGauge(const std::string& name, std::function<double()> getter)
+{
+    std::lock_guard<std::mutex> lock(gaugeMutex_);
+    gauges_[name] = std::move(getter);
+}
+
 void ServiceMonitor::GetStats(std::map<std::string, std::string>& stats)
 {
+    uint64_t totalRequests = 0;
+    uint64_t totalSuccess = 0;
+    uint64_t totalFailures = 0;
+    uint64_t totalLatency = 0;
+    uint64_t maxLatency = 0;
+    uint64_t minLatency = UINT64_MAX;
+
+    // 汇总各方法的分片，服务级别的统计为所有方法之和
+    int count = methodCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        const Method* method = methods_[i].load(std::memory_order_acquire);
+        uint64_t requests = 0;
+        uint64_t success = 0;
+        uint64_t failures = 0;
+        uint64_t latency = 0;
+        for (const Counters& counters : method->shards) {
+            success += counters.success.load(std::memory_order_relaxed);
+            failures += counters.failures.load(std::memory_order_relaxed);
+            latency += counters.latency.load(std::memory_order_relaxed);
+            maxLatency = std::max(maxLatency, counters.maxLatency.load(std::memory_order_relaxed));
+            minLatency = std::min(minLatency, counters.minLatency.load(std::memory_order_relaxed));
+        }
+        requests = success + failures;
+        totalRequests += requests;
+        totalSuccess += success;
+        totalFailures += failures;
+        totalLatency += latency;
+
+        if (requests == 0) {
+            continue;
+        }
+        std::string prefix = "method_" + method->name + "_";
+        stats[prefix + "requests"] = std::to_string(requests);
+        stats[prefix + "success"] = std::to_string(success);
+        stats[prefix + "failures"] = std::to_string(failures);
+        stats[prefix + "avg_latency_ms"] = std::to_string(static_cast<double>(latency) / requests);
+    }
+
     stats["service_name"] = serviceName_;
-    stats["total_requests"] = std::to_string(totalRequests_.load());
-    stats["successful_requests"] = std::to_string(successfulRequests_.load());
-    stats["failed_requests"] = std::to_string(failedRequests_.load());
-    
-    uint64_t totalRequests = totalRequests_.load();
+    stats["total_requests"] = std::to_string(totalRequests);
+    stats["successful_requests"] = std::to_string(totalSuccess);
+    stats["failed_requests"] = std::to_string(totalFailures);
+
     if (totalRequests > 0) {
-        double avgLatency = static_cast<double>(totalLatency_.load()) / totalRequests;
+        double avgLatency = static_cast<double>(totalLatency) / totalRequests;
         stats["average_latency_ms"] = std::to_string(avgLatency);
     } else {
         stats["average_latency_ms"] = "0";
     }
-    
-    stats["max_latency_ms"] = std::to_string(maxLatency_.load());
-    stats["min_latency_ms"] = std::to_string(minLatency_.load() == UINT64_MAX ? 0 : minLatency_.load());
-    
-    // 添加方法级别的统计
-    for (const auto& pair : methodRequests_) {
-        const std::string& method = pair.first;
-        std::string prefix = "method_" + method + "_";
-        
-        stats[prefix + "requests"] = std::to_string(pair.second.load());
-        stats[prefix + "success"] = std::to_string(methodSuccess_[method].load());
-        stats[prefix + "failures"] = std::to_string(methodFailures_[method].load());
-        
-        uint64_t requests = pair.second.load();
-        if (requests > 0) {
-            double avgLatency = static_cast<double>(methodLatency_[method].load()) / requests;
-            stats[prefix + "avg_latency_ms"] = std::to_string(avgLatency);
+
+    stats["max_latency_ms"] = std::to_string(maxLatency);
+    stats["min_latency_ms"] = std::to_string(minLatency == UINT64_MAX ? 0 : minLatency);
+
+    // 添加错误统计
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        for (const auto& pair : errorCounts_) {
+            stats["error_" + pair.first] = std::to_string(pair.second);
         }
     }
-    
-    // 添加错误统计
-    for (const auto& pair : errorCounts_) {
-        stats["error_" + pair.first] = std::to_string(pair.second.load());
+
+    // 添加瞬时指标
+    std::lock_guard<std::mutex> lock(gaugeMutex_);
+    for (const auto& pair : gauges_) {
+        stats["gauge_" + pair.first] = std::to_string(pair.second());
     }
 }
 
 void ServiceMonitor::ResetStats()
 {
-    totalRequests_ = 0;
-    successfulRequests_ = 0;
-    failedRequests_ = 0;
-    totalLatency_ = 0;
-    maxLatency_ = 0;
-    minLatency_ = UINT64_MAX;
-    
-    for (auto& pair : methodRequests_) {
-        pair.second = 0;
-    }
-    
-    for (auto& pair : methodSuccess_) {
-        pair.second = 0;
-    }
-    
-    for (auto& pair : methodFailures_) {
-        pair.second = 0;
-    }
-    
-    for (auto& pair : methodLatency_) {
-        pair.second = 0;
-    }
-    
-    for (auto& pair : errorCounts_) {
-        pair.second = 0;
-    }
-    
+    // 与并发的记录之间不做同步，重置期间的少量记录可能保留，独占分片上重置前的值也可能被写回
+    int count = methodCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        Method* method = methods_[i].load(std::memory_order_acquire);
+        for (Counters& counters : method->shards) {
+            counters.success = 0;
+            counters.failures = 0;
+            counters.latency = 0;
+            counters.maxLatency = 0;
+            counters.minLatency = UINT64_MAX;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        for (auto& pair : errorCounts_) {
+            pair.second = 0;
+        }
+    }
+
     LOG_INFO << "ServiceMonitor stats reset for " << serviceName_;
-}
\ No newline at end of file
+}
@@ -5,46 +5,92 @@
 #include <atomic>
 #include <map>
 #include <string>
-#include <muduo/base/Logging.h>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
 
-// 服务监控指标
+/*
+    服务监控指标，各方法可被多个线程同时调用
+    方法事先注册得到整数句柄，记录时按句柄直接定位计数器，不查表、不加锁、不分配内存。
+    每个方法的计数器按线程分片，每片独占缓存行；GetStats时汇总所有分片。
+    前kShards-1个记录过的线程各独占一片，只有本线程写，用普通的读加写更新原子变量，没有原子读改写指令；
+    之后的线程共用最后一片，用原子加更新。
+*/
 class ServiceMonitor
 {
 public:
+    // 方法句柄
+    using MethodId = int;
+    static const MethodId kInvalidMethod = -1;
+
     ServiceMonitor(const std::string& serviceName);
-    
-    // 记录请求
+    ~ServiceMonitor();
+
+    // 注册方法，同名方法返回同一句柄；方法数超过上限时返回kInvalidMethod，其记录被忽略
+    MethodId RegisterMethod(const std::string& method);
+
+    // 记录请求，无锁
+    void RecordRequest(MethodId method, bool success, int64_t latencyMs);
+
+    // 按方法名记录请求，每次都要加锁查找句柄，热路径应先注册再按句柄记录
     void RecordRequest(const std::string& method, bool success, int64_t latencyMs);
-    
+
     // 记录错误
     void RecordError(const std::string& method, const std::string& errorType);
-    
+
+    // 注册瞬时指标，GetStats时调用getter取值，如缓存命中率
+    void RegisterGauge(const std::string& name, std::function<double()> getter);
+
     // 获取服务统计信息
     void GetStats(std::map<std::string, std::string>& stats);
-    
+
     // 重置统计信息
     void ResetStats();
-    
+
 private:
+    static const int kShards = 32;
+    static const int kMaxMethods = 1024;
+
+    // 一个分片上的计数器，独占缓存行
+    struct alignas(64) Counters
+    {
+        std::atomic<uint64_t> success{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> latency{0};
+        std::atomic<uint64_t> maxLatency{0};
+        std::atomic<uint64_t> minLatency{UINT64_MAX};
+    };
+
+    // 一个方法的全部分片
+    struct Method
+    {
+        explicit Method(const std::string& methodName) : name(methodName) {}
+        std::string name;
+        Counters shards[kShards];
+    };
+
+    // 当前线程的分片序号，exclusive表示该分片只有当前线程写
+    static int ShardIndex(bool& exclusive);
+    // 更新计数器，独占的分片不需要原子读改写
+    static void Add(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive);
+    static void UpdateMax(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive);
+    static void UpdateMin(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive);
+
     // 服务名称
     std::string serviceName_;
-    
-    // 请求计数
-    std::atomic<uint64_t> totalRequests_;
-    std::atomic<uint64_t> successfulRequests_;
-    std::atomic<uint64_t> failedRequests_;
-    
-    // 延迟统计
-    std::atomic<uint64_t> totalLatency_;
-    std::atomic<uint64_t> maxLatency_;
-    std::atomic<uint64_t> minLatency_;
-    
-    // 方法级别的统计
-    std::map<std::string, std::atomic<uint64_t>> methodRequests_;
-    std::map<std::string, std::atomic<uint64_t>> methodSuccess_;
-    std::map<std::string, std::atomic<uint64_t>> methodFailures_;
-    std::map<std::string, std::atomic<uint64_t>> methodLatency_;
-    
+
+    // 方法表，注册后不再移除；methodCount_之前的元素均已发布
+    std::atomic<Method*> methods_[kMaxMethods];
+    std::atomic<int> methodCount_;
+    std::mutex registerMutex_;
+    std::unordered_map<std::string, MethodId> methodIds_;
+
     // 错误统计
-    std::map<std::string, std::atomic<uint64_t>> errorCounts_;
-};
\ No newline at end of file
+    std::mutex errorMutex_;
+    std::map<std::string, uint64_t> errorCounts_;
+
+    // 瞬时指标
+    std::mutex gaugeMutex_;
+    std::map<std::string, std::function<double()>> gauges_;
+};
@@ -0,0 +1,75 @@
+// 业务线程池基准：部分消息触发慢查询时，廉价消息的排队延迟
+// workers=0 等同于旧实现，所有处理都在IO线程上串行执行
+// 同一连接上排在慢查询之后的消息仍要等待，体现在max上；p99反映其他连接是否受影响
+#include "businesspool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+using namespace chrono;
+
+static void runCase(int workers, int messages, int connections, int slowEvery, int slowMs)
+{
+    BusinessPool pool(workers);
+    pool.start();
+
+    mutex latencyMutex;
+    vector<double> cheapLatency;
+    atomic_int done(0);
+
+    // 模拟IO线程：每隔100us到达一条消息
+    auto begin = steady_clock::now();
+    for (int i = 0; i < messages; ++i)
+    {
+        auto arrival = begin + microseconds(100 * i);
+        this_thread::sleep_until(arrival);
+        bool slow = (i % slowEvery == 0);
+        pool.run(i % connections, [&, arrival, slow]()
+                 {
+            if (slow)
+            {
+                // 模拟一次慢SQL
+                this_thread::sleep_for(milliseconds(slowMs));
+            }
+            else
+            {
+                double us = duration<double, micro>(steady_clock::now() - arrival).count();
+                lock_guard<mutex> lock(latencyMutex);
+                cheapLatency.push_back(us);
+            }
+            done++; });
+    }
+    while (done.load() < messages)
+    {
+        this_thread::sleep_for(milliseconds(1));
+    }
+    pool.stop();
+
+    sort(cheapLatency.begin(), cheapLatency.end());
+    auto pct = [&](double p)
+    { return cheapLatency[static_cast<size_t>(p * (cheapLatency.size() - 1))]; };
+    cout << "workers=" << workers
+         << " cheap p50=" << pct(0.50) << "us"
+         << " p99=" << pct(0.99) << "us"
+         << " max=" << cheapLatency.back() << "us" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    int messages = argc > 1 ? atoi(argv[1]) : 5000;
+    int slowEvery = argc > 2 ? atoi(argv[2]) : 1000;
+    int slowMs = argc > 3 ? atoi(argv[3]) : 20;
+    int connections = 64;
+
+    cout << messages << " messages, 1 in " << slowEvery << " takes " << slowMs << "ms" << endl;
+    runCase(0, messages, connections, slowEvery, slowMs);
+    runCase(4, messages, connections, slowEvery, slowMs);
+    runCase(16, messages, connections, slowEvery, slowMs);
+    return 0;
+}
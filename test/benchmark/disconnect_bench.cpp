@@ -0,0 +1,123 @@
+// 断连风暴基准：10万在线用户同时掉线
+// 对比按连接线性扫描在线表(旧实现) 与 通过ChatSession记录的userid在OnlineUserRegistry中直接定位(现实现)
+// 现实现直接使用服务器的OnlineUserRegistry和ChatSession，步骤与Chatservice::clientCloseException一致
+#include "onlineuserregistry.hpp"
+#include "chatsession.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+
+using namespace std;
+using namespace chrono;
+
+// 连接占位：在线表只保存和比较TcpConnectionPtr，不访问连接本身，
+// 用别名构造的TcpConnectionPtr共享一个占位对象的控制块，拷贝和引用计数的开销与真实连接相同
+static TcpConnectionPtr makeStubConn()
+{
+    auto owner = make_shared<char>();
+    return TcpConnectionPtr(owner, reinterpret_cast<TcpConnection *>(owner.get()));
+}
+
+// 会话本应通过setContext挂在连接上，这里与连接放在一起
+struct StubConn
+{
+    ChatSessionPtr session;
+    TcpConnectionPtr conn;
+};
+
+static vector<shared_ptr<StubConn>> makeConns(int users)
+{
+    vector<shared_ptr<StubConn>> conns;
+    conns.reserve(users);
+    for (int id = 0; id < users; ++id)
+    {
+        auto stub = make_shared<StubConn>();
+        stub->session = make_shared<ChatSession>(nullptr, id);
+        stub->session->userid = id;
+        stub->conn = makeStubConn();
+        conns.push_back(stub);
+    }
+    return conns;
+}
+
+// 旧实现：一把锁保护的userid => 连接表，每次断连遍历整张表
+static double linearScan(const vector<shared_ptr<StubConn>> &conns, int storm)
+{
+    unordered_map<int, TcpConnectionPtr> connMap;
+    for (const auto &stub : conns)
+    {
+        connMap.insert({stub->session->userid, stub->conn});
+    }
+    mutex connMutex;
+    auto begin = steady_clock::now();
+    for (int i = 0; i < storm; ++i)
+    {
+        lock_guard<mutex> lock(connMutex);
+        for (auto it = connMap.begin(); it != connMap.end(); ++it)
+        {
+            if (it->second == conns[i]->conn)
+            {
+                connMap.erase(it);
+                break;
+            }
+        }
+    }
+    return duration<double, micro>(steady_clock::now() - begin).count();
+}
+
+// 现实现：从连接会话取userid后在分片的在线表中O(1)删除
+static double sessionIndex(const vector<shared_ptr<StubConn>> &conns, OnlineUserRegistry &registry)
+{
+    auto begin = steady_clock::now();
+    for (const auto &stub : conns)
+    {
+        int userid = stub->session->userid.exchange(-1);
+        if (userid == -1)
+        {
+            continue;
+        }
+        registry.remove(userid, stub->conn);
+    }
+    return duration<double, micro>(steady_clock::now() - begin).count();
+}
+
+int main(int argc, char **argv)
+{
+    int users = argc > 1 ? atoi(argv[1]) : 100000;
+    // 线性扫描为O(n^2)，默认只测一部分断连
+    int linearStorm = argc > 2 ? atoi(argv[2]) : 2000;
+    linearStorm = min(linearStorm, users);
+
+    vector<shared_ptr<StubConn>> conns = makeConns(users);
+
+    // 以随机顺序断开
+    mt19937 gen(42);
+    shuffle(conns.begin(), conns.end(), gen);
+    double linearUs = linearScan(conns, linearStorm);
+
+    OnlineUserRegistry registry;
+    for (const auto &stub : conns)
+    {
+        registry.add(stub->session->userid, stub->conn);
+    }
+    shuffle(conns.begin(), conns.end(), gen);
+    double indexUs = sessionIndex(conns, registry);
+    if (registry.size() != 0)
+    {
+        cerr << "registry not empty after storm: " << registry.size() << endl;
+        return 1;
+    }
+
+    cout << "online users: " << users << endl;
+    cout << "linear scan : " << linearStorm << " disconnects, total " << linearUs / 1000 << " ms, "
+         << linearUs / linearStorm << " us/disconnect" << endl;
+    cout << "session index: " << users << " disconnects, total " << indexUs / 1000 << " ms, "
+         << indexUs / users << " us/disconnect" << endl;
+    return 0;
+}
@@ -0,0 +1,159 @@
+// 登录响应组装基准：1000个好友、100个群(每群50人)
+// 旧实现每个元素单独dump成字符串再整体dump；流式写入器直接追加到复用的字符串
+#include "loginresponse.hpp"
+#include "json.hpp"
+#include "public.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+using namespace chrono;
+using json = nlohmann::json;
+
+// 旧实现：与改造前Chatservice::login中的组装逻辑相同
+static string legacyBuild(const User &user, const vector<string> &offlinemsg,
+                          const vector<User> &friendvec, const vector<Group> &groupuserVec)
+{
+    json response;
+    response["msgid"] = LOGIN_MSG_ACK;
+    response["errno"] = 0;
+    response["id"] = user.getId();
+    response["name"] = user.getName();
+    if (!offlinemsg.empty())
+    {
+        response["offlinemsg"] = offlinemsg;
+    }
+    if (!friendvec.empty())
+    {
+        vector<string> vec2;
+        for (const User &user : friendvec)
+        {
+            json js;
+            js["id"] = user.getId();
+            js["name"] = user.getName();
+            js["state"] = user.getState();
+            vec2.push_back(js.dump());
+        }
+        response["friends"] = vec2;
+    }
+    if (!groupuserVec.empty())
+    {
+        vector<string> groupvec;
+        for (const Group &group : groupuserVec)
+        {
+            json grpjs;
+            grpjs["groupid"] = group.getId();
+            grpjs["groupname"] = group.getName();
+            grpjs["groupdesc"] = group.getDesc();
+            vector<string> uservec;
+            for (const GroupUser &groupuser : group.getGroupUsers())
+            {
+                json js;
+                js["id"] = groupuser.getId();
+                js["name"] = groupuser.getName();
+                js["state"] = groupuser.getState();
+                js["role"] = groupuser.getRole();
+                uservec.push_back(js.dump());
+            }
+            grpjs["groupuser"] = uservec;
+            groupvec.push_back(grpjs.dump());
+        }
+        response["groups"] = groupvec;
+    }
+    return response.dump();
+}
+
+// 把兼容格式中的字符串元素展开，便于和原生格式比较
+static json expand(const json &js)
+{
+    if (js.is_string())
+    {
+        json inner = json::parse(js.get<string>(), nullptr, false);
+        return inner.is_discarded() ? js : expand(inner);
+    }
+    if (js.is_array() || js.is_object())
+    {
+        json result = js;
+        for (auto it = result.begin(); it != result.end(); ++it)
+        {
+            *it = expand(*it);
+        }
+        return result;
+    }
+    return js;
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+
+    User user(1, "bench\"user", "", "online");
+    vector<string> offlinemsg(20, "{\"msgid\":6,\"id\":2,\"name\":\"li si\",\"msg\":\"hello\\nworld\"}");
+    vector<User> friends;
+    for (int i = 0; i < 1000; ++i)
+    {
+        friends.emplace_back(1000 + i, "friend" + to_string(i), "", i % 3 ? "offline" : "online");
+    }
+    vector<Group> groups;
+    for (int g = 0; g < 100; ++g)
+    {
+        Group group(g, "group" + to_string(g), "desc of group " + to_string(g));
+        for (int m = 0; m < 50; ++m)
+        {
+            GroupUser member;
+            member.setId(1000 + (g * 50 + m) % 1000);
+            member.setName("member" + to_string(m));
+            member.setState(m % 2 ? "offline" : "online");
+            member.setRole(m == 0 ? "creator" : "normal");
+            group.getGroupUsers().push_back(member);
+        }
+        groups.push_back(group);
+    }
+
+    // 三种输出语义必须一致
+    string legacy = legacyBuild(user, offlinemsg, friends, groups);
+    string compat, nested;
+    buildLoginResponse(compat, user, offlinemsg, friends, groups, false);
+    buildLoginResponse(nested, user, offlinemsg, friends, groups, true);
+    if (expand(json::parse(legacy)) != expand(json::parse(compat)) ||
+        expand(json::parse(legacy)) != expand(json::parse(nested)))
+    {
+        cerr << "login response mismatch" << endl;
+        return 1;
+    }
+
+    size_t sink = 0;
+    auto begin = steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        sink += legacyBuild(user, offlinemsg, friends, groups).size();
+    }
+    double legacyUs = duration<double, micro>(steady_clock::now() - begin).count() / rounds;
+
+    string out;
+    begin = steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        out.clear();
+        buildLoginResponse(out, user, offlinemsg, friends, groups, false);
+        sink += out.size();
+    }
+    double compatUs = duration<double, micro>(steady_clock::now() - begin).count() / rounds;
+
+    begin = steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        out.clear();
+        buildLoginResponse(out, user, offlinemsg, friends, groups, true);
+        sink += out.size();
+    }
+    double nestedUs = duration<double, micro>(steady_clock::now() - begin).count() / rounds;
+
+    cout << "legacy nested dump:      " << legacyUs << " us/response, " << legacy.size() << " bytes" << endl;
+    cout << "writer, compat strings:  " << compatUs << " us/response, " << compat.size() << " bytes" << endl;
+    cout << "writer, native arrays:   " << nestedUs << " us/response, " << nested.size() << " bytes" << endl;
+    return sink == 0;
+}
@@ -0,0 +1,89 @@
+// 任务交接队列基准：多个IO线程向一个工作线程投递任务
+// 旧方式：LockQueue，每次Push加锁并notify_one，Pop逐个拷贝任务
+// 新方式：MpscQueue，生产者CAS入队，消费者成批移出，消费者睡眠时才需要唤醒
+// 任务类型与业务线程池相同(std::function)，统计所有任务被消费者执行完的吞吐
+// 用法: queue_bench [tasks]
+#include "lockqueue.h"
+#include "mpscqueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace chrono;
+
+using Task = function<void()>;
+
+// 与业务线程池的默认队列上限一致
+static const size_t kQueueSize = 10000;
+
+template <typename PushFunc, typename ConsumeFunc>
+static double runCase(int producers, int tasks, PushFunc push, ConsumeFunc consume)
+{
+    int perProducer = tasks / producers;
+    int total = perProducer * producers;
+    auto begin = steady_clock::now();
+    thread consumer([&]() { consume(total); });
+    vector<thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < perProducer; ++i)
+            {
+                push(p, i);
+            }
+        });
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+    consumer.join();
+    double sec = duration<double>(steady_clock::now() - begin).count();
+    return total / sec / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    int tasks = argc > 1 ? atoi(argv[1]) : 2000000;
+    uint64_t sink = 0;
+
+    cout << "producers  LockQueue(Mops/s)  MpscQueue(Mops/s)" << endl;
+    for (int producers : {1, 4, 16})
+    {
+        LockQueue<Task> lockQueue;
+        double lockRate = runCase(producers, tasks,
+            [&](int p, int i) { lockQueue.Push([&sink, p, i]() { sink += p + i; }); },
+            [&](int total) {
+                for (int n = 0; n < total; ++n)
+                {
+                    lockQueue.Pop()();
+                }
+            });
+
+        MpscQueue<Task> mpscQueue(kQueueSize);
+        double mpscRate = runCase(producers, tasks,
+            [&](int p, int i) { mpscQueue.Push([&sink, p, i]() { sink += p + i; }); },
+            [&](int total) {
+                vector<Task> batch;
+                batch.reserve(64);
+                for (int n = 0; n < total;)
+                {
+                    n += mpscQueue.PopBatch(batch, 64);
+                    for (Task &task : batch)
+                    {
+                        task();
+                    }
+                    batch.clear();
+                }
+            });
+
+        cout << producers << "          " << lockRate << "            " << mpscRate << endl;
+    }
+    cout << "checksum: " << sink << endl;
+    return 0;
+}
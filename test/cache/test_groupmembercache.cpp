@@ -0,0 +1,114 @@
+#include "groupmembercache.hpp"
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "✓ " : "✗ ") << what << endl;
+    if (!ok)
+    {
+        ++failures;
+    }
+}
+
+// 模拟数据库：available为false时加载失败
+struct FakeLoader
+{
+    bool available = true;
+    vector<int> members;
+    int calls = 0;
+
+    GroupMemberCache::Loader loader()
+    {
+        return [this](int, vector<int> &out)
+        {
+            ++calls;
+            if (!available)
+            {
+                return false;
+            }
+            out = members;
+            return true;
+        };
+    }
+};
+
+// 加载失败且没有旧数据：返回nullptr，不写缓存
+void testFailureWithoutEntry()
+{
+    cout << "\n=== 测试1：加载失败且没有缓存 ===" << endl;
+    GroupMemberCache cache(300);
+    FakeLoader db;
+    db.available = false;
+
+    GroupMemberCache::MemberList list = cache.get(1, db.loader());
+    check(list == nullptr, "加载失败时返回nullptr");
+    check(cache.size() == 0, "加载失败的结果没有写入缓存");
+    check(cache.loadFailures() == 1, "记录一次加载失败");
+
+    // 数据库恢复后重新加载到正确的成员
+    db.available = true;
+    db.members = {3, 1, 2};
+    list = cache.get(1, db.loader());
+    check(list != nullptr && *list == vector<int>({1, 2, 3}), "数据库恢复后加载到成员");
+    check(db.calls == 2, "恢复后再次调用loader");
+}
+
+// 缓存过期后加载失败：返回过期的旧数据，下次仍重新加载
+void testFailureWithStaleEntry()
+{
+    cout << "\n=== 测试2：缓存过期后加载失败 ===" << endl;
+    GroupMemberCache cache(1);
+    FakeLoader db;
+    db.members = {10, 20};
+
+    GroupMemberCache::MemberList list = cache.get(2, db.loader());
+    check(list != nullptr && list->size() == 2, "首次加载成功");
+
+    this_thread::sleep_for(chrono::milliseconds(1100));
+    db.available = false;
+    list = cache.get(2, db.loader());
+    check(list != nullptr && *list == vector<int>({10, 20}), "加载失败时返回过期的旧成员列表");
+
+    db.available = true;
+    db.members = {10, 20, 30};
+    list = cache.get(2, db.loader());
+    check(list != nullptr && list->size() == 3, "失败没有刷新过期时间，下次重新加载");
+    check(db.calls == 3, "每次过期访问都调用loader");
+}
+
+// 加载成功后命中缓存，不再调用loader
+void testSuccessIsCached()
+{
+    cout << "\n=== 测试3：加载成功后命中缓存 ===" << endl;
+    GroupMemberCache cache(300);
+    FakeLoader db;
+    db.members = {5};
+
+    cache.get(3, db.loader());
+    GroupMemberCache::MemberList list = cache.get(3, db.loader());
+    check(list != nullptr && *list == vector<int>({5}), "命中缓存返回成员");
+    check(db.calls == 1, "命中时不调用loader");
+
+    // 空群是合法结果，同样缓存
+    db.members.clear();
+    cache.get(4, db.loader());
+    list = cache.get(4, db.loader());
+    check(list != nullptr && list->empty(), "空群被缓存为空列表");
+    check(db.calls == 2, "空群命中时不调用loader");
+}
+
+int main()
+{
+    testFailureWithoutEntry();
+    testFailureWithStaleEntry();
+    testSuccessIsCached();
+
+    cout << "\n" << (failures == 0 ? "全部测试通过" : "存在失败的测试") << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// 离线消息写入基准：每次新建MySQL连接 vs 连接池+预处理语句 vs 异步批量写入
+// 运行前需要可用的chat库，基准结束后会删除测试用户的离线消息
+#include "db.h"
+#include "offlinemsgmodel.hpp"
+#include "offlinemsgwriter.hpp"
+#include "connectionpool.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace chrono;
+
+// 测试用的userid，避免与真实用户冲突
+static const int kBenchUserId = -20240;
+
+// 旧实现：每次insert都完整地建连、认证、执行、断开
+static bool legacyInsert(int userid, const string &msg)
+{
+    char sql[1024] = {0};
+    sprintf(sql, "insert into OfflineMessage values(%d, '%s')", userid, msg.c_str());
+    MySQL database;
+    if (database.connect())
+    {
+        return database.update(sql);
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 2000;
+    string msg = "{\"msgid\":6,\"id\":1,\"name\":\"bench\",\"toid\":2,\"msg\":\"hello\",\"time\":\"2024-01-01 00:00:00\"}";
+
+    OfflineMsgModel model;
+    // 预热连接池
+    model.remove(kBenchUserId);
+
+    auto begin = steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        legacyInsert(kBenchUserId, msg);
+    }
+    double legacySec = duration<double>(steady_clock::now() - begin).count();
+    model.remove(kBenchUserId);
+
+    begin = steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        model.insert(kBenchUserId, msg);
+    }
+    double pooledSec = duration<double>(steady_clock::now() - begin).count();
+    model.remove(kBenchUserId);
+
+    // 模拟大群扇出：所有消息交给写入线程，合并成多行insert
+    OfflineMsgWriter writer;
+    writer.start();
+    begin = steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        writer.append(kBenchUserId, msg);
+    }
+    // stop写完队列中的全部消息才返回
+    writer.stop();
+    double batchedSec = duration<double>(steady_clock::now() - begin).count();
+    OfflineMsgWriter::Stats stats = writer.stats();
+    model.remove(kBenchUserId);
+
+    cout << "legacy connect-per-insert: " << count / legacySec << " inserts/s" << endl;
+    cout << "pool + prepared statement: " << count / pooledSec << " inserts/s" << endl;
+    cout << "write-behind batch insert: " << count / batchedSec << " inserts/s, "
+         << stats.flushes << " round trips, max flush " << stats.maxFlushUs << " us" << endl;
+    return 0;
+}
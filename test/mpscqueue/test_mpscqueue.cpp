@@ -0,0 +1,223 @@
+#include "mpscqueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "✓ " : "✗ ") << what << endl;
+    if (!ok)
+    {
+        ++failures;
+    }
+}
+
+// 元素编码为 生产者编号 << 32 | 序号
+static uint64_t encode(int producer, uint32_t seq)
+{
+    return (static_cast<uint64_t>(producer) << 32) | seq;
+}
+
+// 多个生产者并发入队，单个消费者取出；检查不丢、不重、每个生产者内部有序
+static void runProducers(size_t capacity, int producers, uint32_t perProducer, const string &name)
+{
+    MpscQueue<uint64_t> queue(capacity);
+    vector<thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&queue, p, perProducer]()
+                             {
+            for (uint32_t i = 0; i < perProducer; ++i)
+            {
+                queue.Push(encode(p, i));
+            } });
+    }
+
+    vector<uint32_t> next(producers, 0);
+    bool ordered = true;
+    bool known = true;
+    uint64_t total = static_cast<uint64_t>(producers) * perProducer;
+    uint64_t received = 0;
+    vector<uint64_t> batch;
+    while (received < total)
+    {
+        batch.clear();
+        received += queue.PopBatch(batch, 64);
+        for (uint64_t value : batch)
+        {
+            int p = static_cast<int>(value >> 32);
+            uint32_t seq = static_cast<uint32_t>(value);
+            if (p < 0 || p >= producers)
+            {
+                known = false;
+                continue;
+            }
+            // 重复或乱序都会让序号对不上
+            if (seq != next[p])
+            {
+                ordered = false;
+            }
+            next[p] = seq + 1;
+        }
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+
+    bool complete = known;
+    for (int p = 0; p < producers; ++p)
+    {
+        complete = complete && next[p] == perProducer;
+    }
+    batch.clear();
+    check(ordered && complete && queue.TryPopBatch(batch, 64) == 0, name);
+}
+
+// 队列满时Push阻塞，消费者取走元素后继续
+static void testBlockingPush()
+{
+    cout << "\n=== 测试3：队列满时Push阻塞 ===" << endl;
+    MpscQueue<int> queue(2);
+    check(queue.TryPush(1) && queue.TryPush(2), "填满容量为2的队列");
+    check(!queue.TryPush(3), "队列满时TryPush失败");
+
+    atomic<bool> pushed(false);
+    thread producer([&]()
+                    {
+        queue.Push(3);
+        pushed = true; });
+    this_thread::sleep_for(chrono::milliseconds(50));
+    check(!pushed, "队列满时Push阻塞");
+
+    vector<int> out;
+    queue.PopBatch(out, 1);
+    producer.join();
+    check(pushed, "消费者腾出槽位后Push返回");
+    queue.PopBatch(out, 8);
+    check(out == vector<int>({1, 2, 3}), "阻塞的元素按顺序入队");
+}
+
+// Close后消费者取完已入队的元素，之后的入队失败，阻塞的生产者被唤醒
+static void testClose()
+{
+    cout << "\n=== 测试4：关闭队列 ===" << endl;
+    MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        queue.Push(int(i));
+    }
+
+    atomic<int> blockedResult(-1);
+    thread producer([&]()
+                    { blockedResult = queue.Push(100) ? 1 : 0; });
+    this_thread::sleep_for(chrono::milliseconds(50));
+    queue.Close();
+    producer.join();
+    check(blockedResult == 0, "阻塞在Push上的生产者在关闭时返回false");
+    check(!queue.TryPush(5) && !queue.Push(6), "关闭后TryPush和Push都失败");
+
+    vector<int> out;
+    while (queue.PopBatch(out, 3) > 0)
+    {
+    }
+    check(out == vector<int>({0, 1, 2, 3}), "关闭前入队的元素全部取出");
+    check(queue.PopBatch(out, 3) == 0, "取完后PopBatch返回0");
+
+    // 关闭与并发入队：返回true的元素必须全部被取出
+    for (int round = 0; round < 50; ++round)
+    {
+        MpscQueue<int> racing(8);
+        atomic<int> accepted(0);
+        vector<thread> producers;
+        for (int p = 0; p < 4; ++p)
+        {
+            producers.emplace_back([&]()
+                                   {
+                while (racing.Push(1))
+                {
+                    ++accepted;
+                } });
+        }
+        int consumed = 0;
+        vector<int> batch;
+        for (int i = 0; i < 100; ++i)
+        {
+            batch.clear();
+            consumed += static_cast<int>(racing.TryPopBatch(batch, 4));
+        }
+        racing.Close();
+        for (;;)
+        {
+            batch.clear();
+            size_t count = racing.PopBatch(batch, 4);
+            if (count == 0)
+            {
+                break;
+            }
+            consumed += static_cast<int>(count);
+        }
+        for (thread &t : producers)
+        {
+            t.join();
+        }
+        if (consumed != accepted)
+        {
+            check(false, "关闭时并发入队的元素全部取出");
+            return;
+        }
+    }
+    check(true, "关闭时并发入队的元素全部取出");
+}
+
+// 只能移动的元素
+static void testMoveOnly()
+{
+    cout << "\n=== 测试5：只能移动的元素 ===" << endl;
+    MpscQueue<unique_ptr<int>> queue(4);
+    unique_ptr<int> value(new int(7));
+    check(queue.TryPush(std::move(value)) && value == nullptr, "入队后元素被移走");
+
+    unique_ptr<int> kept(new int(8));
+    queue.Push(unique_ptr<int>(new int(9)));
+    queue.Push(unique_ptr<int>(new int(10)));
+    queue.Push(unique_ptr<int>(new int(11)));
+    check(!queue.TryPush(std::move(kept)) && kept != nullptr && *kept == 8, "入队失败时元素保持不变");
+
+    vector<unique_ptr<int>> out;
+    queue.PopBatch(out, 8);
+    check(out.size() == 4 && *out[0] == 7 && *out[3] == 11, "取出的元素完整");
+
+    // 析构时释放队列中剩余的元素(配合ASan检查泄漏)
+    MpscQueue<unique_ptr<int>> leftover(4);
+    leftover.Push(unique_ptr<int>(new int(1)));
+    check(leftover.SizeApprox() == 1, "剩余元素随队列析构释放");
+}
+
+int main()
+{
+    cout << "=== 测试1：多生产者不丢不重、各自有序 ===" << endl;
+    runProducers(1024, 1, 100000, "1个生产者");
+    runProducers(1024, 4, 50000, "4个生产者");
+    runProducers(1024, 16, 10000, "16个生产者");
+
+    cout << "\n=== 测试2：小容量下反复回绕 ===" << endl;
+    runProducers(2, 4, 20000, "容量2，4个生产者");
+    runProducers(4, 8, 10000, "容量4，8个生产者");
+
+    testBlockingPush();
+    testClose();
+    testMoveOnly();
+
+    cout << "\n" << (failures == 0 ? "全部测试通过" : "存在失败的测试") << endl;
+    return failures == 0 ? 0 : 1;
+}
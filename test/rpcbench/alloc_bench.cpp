@@ -0,0 +1,210 @@
+// rpc编解码分配基准：统计一次调用(请求编码->服务端解码->响应编码->调用方解码)的堆分配次数和耗时
+// 旧方式：参数和header各自序列化成字符串再拼接，服务端retrieveAllAsString后substr出header和参数
+// 新方式：MprpcCodec直接序列化进预先定好大小的缓冲区，解码时在接收缓冲区上原地反序列化
+// 不含网络收发，请求/响应消息对象在两种方式中都复用，只比较框架本身的开销
+// 另比较服务端每次调用新建request/response：逐个new/delete vs 分配在回收的调用arena上
+// 用法: alloc_bench [calls]
+#include "mprpccodec.h"
+#include "mprpcarena.h"
+#include "user.pb.h"
+#include <muduo/net/Buffer.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace std;
+using namespace chrono;
+
+static atomic<uint64_t> g_allocs(0);
+
+void *operator new(size_t size)
+{
+    ++g_allocs;
+    void *p = malloc(size);
+    if (p == nullptr)
+    {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+// 旧方式，与改造前的Mprpcchannel::CallMethod和MprpcProvider::OnMessage/SendmprpcResponse相同
+static bool legacyCall(const fixbug::LoginRequest &request, fixbug::LoginRequest &serverRequest,
+                       const fixbug::LoginResponse &serverResponse, fixbug::LoginResponse &response,
+                       muduo::net::Buffer &wire)
+{
+    // 调用方
+    string argsStr;
+    request.SerializeToString(&argsStr);
+    mprpc::mpRpcHeader header;
+    header.set_service_name("UserServiceRPC");
+    header.set_method_name("Login");
+    header.set_args_size(argsStr.size());
+    string headerStr;
+    header.SerializePartialToString(&headerStr);
+    uint32_t headerSize = headerStr.size();
+    string sendBuf;
+    sendBuf.insert(0, string((char *)&headerSize, 4));
+    sendBuf += headerStr;
+    sendBuf += argsStr;
+    wire.append(sendBuf.data(), sendBuf.size());
+
+    // 服务端
+    string recvBuf = wire.retrieveAllAsString();
+    recvBuf.copy((char *)&headerSize, 4, 0);
+    string serverHeaderStr = recvBuf.substr(4, headerSize);
+    mprpc::mpRpcHeader serverHeader;
+    if (!serverHeader.ParseFromString(serverHeaderStr))
+    {
+        return false;
+    }
+    string serverArgs = recvBuf.substr(4 + headerSize, serverHeader.args_size());
+    if (!serverRequest.ParseFromString(serverArgs))
+    {
+        return false;
+    }
+    string responseStr;
+    serverResponse.SerializePartialToString(&responseStr);
+    wire.append(responseStr.data(), responseStr.size());
+
+    // 调用方
+    string recvResponse = wire.retrieveAllAsString();
+    return response.ParseFromArray(recvResponse.data(), recvResponse.size());
+}
+
+// 新方式
+static bool codecCall(const fixbug::LoginRequest &request, fixbug::LoginRequest &serverRequest,
+                      const fixbug::LoginResponse &serverResponse, fixbug::LoginResponse &response,
+                      muduo::net::Buffer &wire, string &serverSendBuf)
+{
+    // 调用方：帧整体移交给IO线程
+    mprpc::mpRpcHeader header;
+    header.set_method_id(MprpcCodec::MethodId("fixbug.UserServiceRPC.Login"));
+    header.set_request_id(1);
+    string sendBuf;
+    if (!MprpcCodec::Encode(header, &request, &sendBuf))
+    {
+        return false;
+    }
+    wire.append(sendBuf.data(), sendBuf.size());
+
+    // 服务端：在接收缓冲区上解码，响应编码到按线程复用的缓冲区
+    mprpc::mpRpcHeader serverHeader;
+    const char *body = nullptr;
+    size_t bodyLen = 0, frameSize = 0;
+    if (MprpcCodec::Decode(&wire, &serverHeader, &body, &bodyLen, &frameSize) != MprpcCodec::kFrameOk ||
+        !serverRequest.ParseFromArray(body, bodyLen))
+    {
+        return false;
+    }
+    wire.retrieve(frameSize);
+    mprpc::mpRpcHeader responseHeader;
+    responseHeader.set_request_id(serverHeader.request_id());
+    responseHeader.set_method_id(serverHeader.method_id());
+    serverSendBuf.clear();
+    if (!MprpcCodec::Encode(responseHeader, &serverResponse, &serverSendBuf))
+    {
+        return false;
+    }
+    wire.append(serverSendBuf.data(), serverSendBuf.size());
+
+    // 调用方
+    mprpc::mpRpcHeader clientHeader;
+    if (MprpcCodec::Decode(&wire, &clientHeader, &body, &bodyLen, &frameSize) != MprpcCodec::kFrameOk ||
+        !response.ParseFromArray(body, bodyLen))
+    {
+        return false;
+    }
+    wire.retrieve(frameSize);
+    return true;
+}
+
+// 服务端处理一次请求：新建request解析参数，新建response填充后编码
+// arena为空时与改造前的MprpcProvider相同，逐个new/delete
+static bool providerCall(const string &args, MprpcArenaPool *pool, string &serverSendBuf)
+{
+    MprpcCallArena *arena = pool ? pool->Acquire() : nullptr;
+    google::protobuf::Arena *a = arena ? arena->Get() : nullptr;
+    google::protobuf::Message *request = fixbug::LoginRequest::default_instance().New(a);
+    bool ok = request->ParseFromArray(args.data(), args.size());
+    auto *response = static_cast<fixbug::LoginResponse *>(fixbug::LoginResponse::default_instance().New(a));
+    response->mutable_response()->set_errcode(0);
+    response->mutable_response()->set_errmsg("ok");
+    response->set_success(true);
+    mprpc::mpRpcHeader header;
+    header.set_request_id(1);
+    serverSendBuf.clear();
+    ok = ok && MprpcCodec::Encode(header, response, &serverSendBuf);
+    if (arena)
+    {
+        pool->Release(arena);
+    }
+    else
+    {
+        delete request;
+        delete response;
+    }
+    return ok;
+}
+
+template <typename Call>
+static void run(const char *name, int calls, Call call)
+{
+    // 预热，让复用的消息和缓冲区达到稳定容量
+    for (int i = 0; i < 100; ++i)
+    {
+        call();
+    }
+    uint64_t allocs = g_allocs;
+    auto begin = steady_clock::now();
+    for (int i = 0; i < calls; ++i)
+    {
+        if (!call())
+        {
+            cerr << name << " failed" << endl;
+            exit(1);
+        }
+    }
+    double ns = duration<double, nano>(steady_clock::now() - begin).count() / calls;
+    cout << name << static_cast<double>(g_allocs - allocs) / calls << " allocs/call, " << ns << " ns/call" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    int calls = argc > 1 ? atoi(argv[1]) : 200000;
+
+    fixbug::LoginRequest request;
+    request.set_name("zhang san with a long enough name");
+    request.set_pwd("123456789012345678901234567890");
+    fixbug::LoginResponse serverResponse;
+    serverResponse.mutable_response()->set_errcode(0);
+    serverResponse.mutable_response()->set_errmsg(string(200, 'x'));
+    serverResponse.set_success(true);
+
+    fixbug::LoginRequest serverRequest;
+    fixbug::LoginResponse response;
+    muduo::net::Buffer wire;
+    string serverSendBuf;
+
+    run("legacy strings:  ", calls, [&]() { return legacyCall(request, serverRequest, serverResponse, response, wire); });
+    run("codec in place:  ", calls, [&]() { return codecCall(request, serverRequest, serverResponse, response, wire, serverSendBuf); });
+
+    string args = request.SerializeAsString();
+    MprpcArenaPool pool;
+    run("provider new/delete: ", calls, [&]() { return providerCall(args, nullptr, serverSendBuf); });
+    run("provider call arena: ", calls, [&]() { return providerCall(args, &pool, serverSendBuf); });
+    return 0;
+}
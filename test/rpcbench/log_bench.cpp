@@ -0,0 +1,162 @@
+// 日志吞吐基准：多个线程同时写日志，统计每秒写入文件的行数
+// 旧方式：每行snprintf成字符串入LockQueue，写线程每行fopen/fputs/fclose一次
+// 新方式：Logger双缓冲，行直接格式化进缓冲区，写线程批量fwrite到一直打开的文件
+// 两种方式都计时到最后一行写入文件为止
+// 另统计低于日志级别的LOG_DEBUG和1/1000采样日志在调用线程上的耗时
+// 用法: log_bench [threads] [lines_per_thread]
+#include "logger.h"
+#include "lockqueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace chrono;
+
+// 旧实现：每行一次fopen/fclose
+class LegacyLogger
+{
+public:
+    LegacyLogger() : _written(0)
+    {
+        thread writer([this]() {
+            for (;;)
+            {
+                time_t now = time(nullptr);
+                tm nowtm;
+                localtime_r(&now, &nowtm);
+                FILE *pf = fopen("legacy-bench-log.txt", "a");
+                if (pf == nullptr)
+                {
+                    cout << "legacy log file open error!" << endl;
+                    exit(EXIT_FAILURE);
+                }
+                pair<LogLevel, string> msg = _que.Pop();
+                string logMsg = msg.second;
+                logMsg.insert(0, "[INFO]");
+                char timeMsg[128] = {0};
+                sprintf(timeMsg, "%d:%d:%d =>", nowtm.tm_hour, nowtm.tm_min, nowtm.tm_sec);
+                logMsg.insert(0, timeMsg);
+                logMsg.append("\n");
+                fputs(logMsg.c_str(), pf);
+                fclose(pf);
+                ++_written;
+            }
+        });
+        writer.detach();
+    }
+
+    void Log(const char *format, int a, int b)
+    {
+        char msg[1024] = {0};
+        snprintf(msg, 1024, format, a, b);
+        _que.Push(make_pair(INFO, string(msg)));
+    }
+
+    uint64_t Written() const { return _written; }
+
+private:
+    LockQueue<pair<LogLevel, string>> _que;
+    atomic<uint64_t> _written;
+};
+
+template <typename LogFunc, typename WaitFunc>
+static double Run(int threads, int lines, LogFunc logLine, WaitFunc waitDone)
+{
+    auto start = steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([t, lines, &logLine]() {
+            for (int i = 0; i < lines; ++i)
+            {
+                logLine(t, i);
+            }
+        });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+    waitDone();
+    double sec = duration<double>(steady_clock::now() - start).count();
+    return threads * static_cast<double>(lines) / sec;
+}
+
+int main(int argc, char **argv)
+{
+    int threads = argc > 1 ? atoi(argv[1]) : 8;
+    int lines = argc > 2 ? atoi(argv[2]) : 100000;
+    const char *format = "user login, userid:%d seq:%d";
+
+    // 旧方式每行开关一次文件，行数太多时耗时过长，按比例缩小
+    int legacyLines = lines / 10 > 0 ? lines / 10 : 1;
+    // 写线程detach后一直阻塞在队列上，对象不析构
+    LegacyLogger &legacy = *new LegacyLogger();
+    double legacyRate = Run(threads, legacyLines,
+        [&](int t, int i) { legacy.Log(format, t, i); },
+        [&]() {
+            uint64_t total = static_cast<uint64_t>(threads) * legacyLines;
+            while (legacy.Written() < total)
+            {
+                this_thread::sleep_for(milliseconds(1));
+            }
+        });
+
+    // 阻塞策略：不丢日志，与旧方式比较写入文件的完整吞吐
+    LoggerOptions options;
+    options.baseName = "bench";
+    options.fullPolicy = LOG_BLOCK;
+    Logger &logger = Logger::getLOGInstance();
+    logger.SetOptions(options);
+    double blockRate = Run(threads, lines,
+        [&](int t, int i) { LOG_INFO("user login, userid:%d seq:%d", t, i); },
+        [&]() { logger.Flush(); });
+
+    // 丢弃策略：写日志的线程不会被磁盘拖慢
+    options.fullPolicy = LOG_DROP;
+    logger.SetOptions(options);
+    uint64_t droppedBefore = logger.Dropped();
+    double dropRate = Run(threads, lines,
+        [&](int t, int i) { LOG_INFO("user login, userid:%d seq:%d", t, i); },
+        [&]() { logger.Flush(); });
+
+    // 默认INFO级别，LOG_DEBUG只剩一次级别判断；采样日志每1000次格式化一次
+    const int hotCalls = 10000000;
+    string method = "UserServiceRpc.Login";
+    auto start = steady_clock::now();
+    for (int i = 0; i < hotCalls; ++i)
+    {
+        LOG_DEBUG("request_id:%d method:%s", i, method.c_str());
+    }
+    double debugNs = duration<double, nano>(steady_clock::now() - start).count() / hotCalls;
+    start = steady_clock::now();
+    for (int i = 0; i < hotCalls; ++i)
+    {
+        LOG_INFO_EVERY_N(1000, "request_id:%d method:%s", i, method.c_str());
+    }
+    double sampledNs = duration<double, nano>(steady_clock::now() - start).count() / hotCalls;
+    start = steady_clock::now();
+    for (int i = 0; i < hotCalls / 10; ++i)
+    {
+        LOG_INFO("request_id:%d method:%s", i, method.c_str());
+    }
+    double infoNs = duration<double, nano>(steady_clock::now() - start).count() / (hotCalls / 10);
+    logger.Flush();
+
+    cout << "threads: " << threads << endl;
+    cout << "legacy fopen per line: " << static_cast<uint64_t>(legacyRate) << " lines/s (" << legacyLines << " lines per thread)" << endl;
+    cout << "async double buffer, block: " << static_cast<uint64_t>(blockRate) << " lines/s (" << lines << " lines per thread)" << endl;
+    cout << "async double buffer, drop: " << static_cast<uint64_t>(dropRate) << " lines/s, dropped "
+         << logger.Dropped() - droppedBefore << endl;
+    cout << "LOG_DEBUG below level: " << debugNs << " ns/call" << endl;
+    cout << "LOG_INFO_EVERY_N(1000): " << sampledNs << " ns/call" << endl;
+    cout << "LOG_INFO: " << infoNs << " ns/call" << endl;
+    return 0;
+}
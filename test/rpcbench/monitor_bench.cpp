@@ -0,0 +1,103 @@
+// 调用统计基准：多个线程同时记录同一组方法的调用结果，统计每次记录的耗时
+// 旧方式：按方法名在std::map中查找计数器，整个方法级别的统计由一把锁保护，每次构造key字符串
+// 新方式：ServiceMonitor事先注册方法得到句柄，按线程分片的计数器上做relaxed原子加，不加锁
+// 用法: monitor_bench [records_per_thread]
+#include "monitor.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace chrono;
+
+// 旧实现的方法级别统计
+class LegacyMonitor
+{
+public:
+    void RecordRequest(const string &method, bool success, int64_t latencyMs)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _requests[method]++;
+        _latency[method] += latencyMs;
+        if (success)
+        {
+            _success[method]++;
+        }
+        else
+        {
+            _failures[method]++;
+        }
+    }
+
+private:
+    mutex _mutex;
+    map<string, atomic<uint64_t>> _requests;
+    map<string, atomic<uint64_t>> _success;
+    map<string, atomic<uint64_t>> _failures;
+    map<string, atomic<uint64_t>> _latency;
+};
+
+static const char *kMethods[] = {"UserServiceRpc.Login", "UserServiceRpc.Register", "MessageServiceRpc.OneChat",
+                                 "FriendServiceRpc.AddFriend", "GroupServiceRpc.GroupChat"};
+static const int kMethodCount = sizeof(kMethods) / sizeof(kMethods[0]);
+
+template <typename RecordFunc>
+static double runCase(int threads, int records, RecordFunc record)
+{
+    auto begin = steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([t, records, &record]() {
+            for (int i = 0; i < records; ++i)
+            {
+                record((t + i) % kMethodCount, (i & 15) != 0, i & 7);
+            }
+        });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+    // 各线程同时记录，每次记录在调用线程上的平均耗时
+    return duration<double, nano>(steady_clock::now() - begin).count() / records;
+}
+
+int main(int argc, char **argv)
+{
+    int records = argc > 1 ? atoi(argv[1]) : 2000000;
+
+    cout << "threads  legacy(ns/record)  handle(ns/record)" << endl;
+    for (int threads : {1, 4, 8})
+    {
+        // 服务端按 service.method 的const string记录，key本身不需要构造
+        vector<string> names(kMethods, kMethods + kMethodCount);
+        LegacyMonitor legacy;
+        double legacyNs = runCase(threads, records, [&](int m, bool success, int64_t latency) {
+            legacy.RecordRequest(names[m], success, latency);
+        });
+
+        ServiceMonitor monitor("MonitorBench");
+        vector<ServiceMonitor::MethodId> ids;
+        for (const string &name : names)
+        {
+            ids.push_back(monitor.RegisterMethod(name));
+        }
+        double handleNs = runCase(threads, records, [&](int m, bool success, int64_t latency) {
+            monitor.RecordRequest(ids[m], success, latency);
+        });
+
+        // 汇总结果应与记录次数一致
+        map<string, string> stats;
+        monitor.GetStats(stats);
+        cout << threads << "        " << legacyNs << "              " << handleNs
+             << "    (total_requests " << stats["total_requests"] << ")" << endl;
+    }
+    return 0;
+}
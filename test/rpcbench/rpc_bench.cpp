@@ -0,0 +1,253 @@
+// 回环rpc基准：进程内启动MprpcProvider发布Login回显服务
+// 旧方式每次调用新建tcp连接、收到响应后关闭；新方式经连接池复用长连接，多个线程的请求在同一连接上按request_id复用；
+// 异步方式在一个EventLoop线程上保持window个在途调用
+// 用法: rpc_bench [calls] [threads] [port] [window]
+// 未配置zookeeper时provider启动前会等待zk连接超时(约10秒)，之后正常提供服务
+#include "mprpcapplication.h"
+#include "mprpccodec.h"
+#include "mprpcclosure.h"
+#include <muduo/net/EventLoop.h>
+#include <muduo/net/EventLoopThread.h>
+#include "user.pb.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace chrono;
+
+// 回显服务：直接把用户名作为errmsg返回
+class EchoService : public fixbug::UserServiceRPC
+{
+public:
+    void Login(google::protobuf::RpcController *controller,
+               const fixbug::LoginRequest *request,
+               fixbug::LoginResponse *response,
+               google::protobuf::Closure *done) override
+    {
+        response->mutable_response()->set_errcode(0);
+        response->mutable_response()->set_errmsg(request->name());
+        response->set_success(true);
+        done->Run();
+    }
+};
+
+// 组装一帧Login请求 （frameLen + headerLen + header + args）
+static string buildFrame(const fixbug::LoginRequest &request, uint64_t requestId)
+{
+    mprpc::mpRpcHeader header;
+    header.set_service_name("UserServiceRPC");
+    header.set_method_name("Login");
+    header.set_request_id(requestId);
+    string frame;
+    MprpcCodec::Encode(header, &request, &frame);
+    return frame;
+}
+
+static bool recvAll(int fd, char *buf, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = recv(fd, buf, len, 0);
+        if (n <= 0)
+        {
+            return false;
+        }
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+// 旧方式：一次调用一条连接
+static bool legacyCall(uint16_t port, const fixbug::LoginRequest &request, fixbug::LoginResponse &response)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (connect(fd, (sockaddr *)&addr, sizeof(addr)) == -1)
+    {
+        close(fd);
+        return false;
+    }
+    string frame = buildFrame(request, 1);
+    bool ok = send(fd, frame.data(), frame.size(), 0) == (ssize_t)frame.size();
+
+    uint32_t frameLen = 0;
+    string frameStr;
+    ok = ok && recvAll(fd, (char *)&frameLen, 4);
+    if (ok)
+    {
+        frameStr.resize(ntohl(frameLen));
+        ok = recvAll(fd, &frameStr[0], frameStr.size());
+    }
+    if (ok)
+    {
+        uint32_t headerLen = 0;
+        memcpy(&headerLen, frameStr.data(), 4);
+        headerLen = ntohl(headerLen);
+        size_t bodyOffset = 4 + headerLen;
+        ok = bodyOffset <= frameStr.size() &&
+             response.ParseFromArray(frameStr.data() + bodyOffset, frameStr.size() - bodyOffset);
+    }
+    close(fd);
+    return ok;
+}
+
+// 多线程跑calls次调用，返回每秒调用数
+template <typename Call>
+static double run(int calls, int threads, Call call, atomic<int> &failed)
+{
+    atomic<int> next(0);
+    vector<thread> workers;
+    auto begin = steady_clock::now();
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&]() {
+            fixbug::LoginRequest request;
+            request.set_name("bench");
+            request.set_pwd("123456");
+            while (next++ < calls)
+            {
+                fixbug::LoginResponse response;
+                if (!call(request, response) || response.response().errmsg() != "bench")
+                {
+                    ++failed;
+                }
+            }
+        });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+    return calls / duration<double>(steady_clock::now() - begin).count();
+}
+
+// 异步调用：一个EventLoop线程上保持window个在途请求，每完成一个再发一个
+static double runAsync(Mprpcchannel &channel, int calls, int window, atomic<int> &failed)
+{
+    struct AsyncCall
+    {
+        fixbug::LoginRequest request;
+        fixbug::LoginResponse response;
+        MprpcController controller;
+    };
+
+    muduo::net::EventLoopThread loopThread;
+    muduo::net::EventLoop *loop = loopThread.startLoop();
+    fixbug::UserServiceRPC_Stub stub(&channel);
+    promise<void> finished;
+    int issued = 0, completed = 0; // 只在loop线程访问
+    function<void()> issue = [&]() {
+        ++issued;
+        auto call = make_shared<AsyncCall>();
+        call->request.set_name("bench");
+        call->request.set_pwd("123456");
+        stub.Login(&call->controller, &call->request, &call->response, new MprpcClosure([&, call]() {
+            if (call->controller.Failed() || call->response.response().errmsg() != "bench")
+            {
+                ++failed;
+            }
+            if (++completed == calls)
+            {
+                finished.set_value();
+            }
+            else if (issued < calls)
+            {
+                issue();
+            }
+        }));
+    };
+
+    auto begin = steady_clock::now();
+    loop->runInLoop([&]() {
+        for (int i = 0; i < window && issued < calls; ++i)
+        {
+            issue();
+        }
+    });
+    finished.get_future().wait();
+    return calls / duration<double>(steady_clock::now() - begin).count();
+}
+
+int main(int argc, char **argv)
+{
+    int calls = argc > 1 ? atoi(argv[1]) : 20000;
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+    uint16_t port = argc > 3 ? atoi(argv[3]) : 18000;
+    int window = argc > 4 ? atoi(argv[4]) : 1000;
+
+    // 临时配置文件，zookeeper地址不可用时只影响服务注册
+    char configPath[] = "/tmp/rpc_bench_XXXXXX";
+    int configFd = mkstemp(configPath);
+    string config = "rpcserverip=127.0.0.1\nrpcserverport=" + to_string(port) +
+                    "\nzookeeperip=127.0.0.1\nzookeeperport=2181\n";
+    write(configFd, config.data(), config.size());
+    close(configFd);
+    char arg0[] = "rpc_bench", arg1[] = "-i";
+    char *initArgv[] = {arg0, arg1, configPath, nullptr};
+    MprpcApplication::Init(3, initArgv);
+
+    thread([]() {
+        MprpcProvider provider;
+        provider.NotifyService(new EchoService());
+        provider.StartMprpc();
+    }).detach();
+
+    // 等待provider开始处理请求
+    fixbug::LoginRequest probe;
+    probe.set_name("bench");
+    fixbug::LoginResponse probeResponse;
+    while (!legacyCall(port, probe, probeResponse))
+    {
+        this_thread::sleep_for(milliseconds(100));
+    }
+    unlink(configPath);
+
+    atomic<int> legacyFailed(0), pooledFailed(0);
+    double legacyQps = run(calls, threads, [port](const fixbug::LoginRequest &request, fixbug::LoginResponse &response) {
+        return legacyCall(port, request, response);
+    }, legacyFailed);
+
+    Mprpcchannel channel("127.0.0.1", port);
+    fixbug::UserServiceRPC_Stub stub(&channel);
+    double pooledQps = run(calls, threads, [&stub](const fixbug::LoginRequest &request, fixbug::LoginResponse &response) {
+        MprpcController controller;
+        stub.Login(&controller, &request, &response, nullptr);
+        return !controller.Failed();
+    }, pooledFailed);
+
+    atomic<int> asyncFailed(0);
+    double asyncQps = runAsync(channel, calls, window, asyncFailed);
+
+    // 多兆字节的请求和响应需要跨多次读取拼成完整的帧
+    fixbug::LoginRequest bigRequest;
+    bigRequest.set_name(string(4 * 1024 * 1024, 'x'));
+    fixbug::LoginResponse bigResponse;
+    MprpcController bigController;
+    stub.Login(&bigController, &bigRequest, &bigResponse, nullptr);
+    bool bigOk = !bigController.Failed() && bigResponse.response().errmsg() == bigRequest.name();
+
+    cout << "4 MB round trip:      " << (bigOk ? "ok" : "failed") << endl;
+    cout << "connect per call:     " << legacyQps << " calls/s, failed " << legacyFailed << endl;
+    cout << "pooled multiplexed:   " << pooledQps << " calls/s, failed " << pooledFailed << endl;
+    cout << "async, " << window << " in flight: " << asyncQps << " calls/s, failed " << asyncFailed << endl;
+    return bigOk ? 0 : 1;
+}
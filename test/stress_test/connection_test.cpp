@@ -46,6 +46,8 @@ private:
             loginMsg["password"] = "123456";
             
             std::string msg = loginMsg.dump();
+            // 添加换行符作为消息分隔符
+            msg += "\n";
             conn->send(msg);
             LOG_INFO << "Login message sent: " << msg;
             
@@ -67,7 +69,16 @@ private:
     }
 
     void onMessage(const TcpConnectionPtr& conn, Buffer* buf, Timestamp time) {
-        std::string message = buf->retrieveAllAsString();
+        // 响应以换行符分隔，一次可能收到多条或半条
+        const char* eol;
+        while ((eol = buf->findEOL()) != nullptr) {
+            std::string message(buf->peek(), eol);
+            buf->retrieveUntil(eol + 1);
+            handleResponse(message);
+        }
+    }
+
+    void handleResponse(const std::string& message) {
         LOG_INFO << "Received: " << message;
         
         try {
@@ -102,6 +113,7 @@ private:
             std::chrono::system_clock::now().time_since_epoch()).count());
         
         std::string msg = chatMsg.dump();
+        msg += "\n";
         conn->send(msg);
         LOG_INFO << "Chat message sent: " << msg;
     }
@@ -96,7 +96,8 @@ class ChatClient:
             return False
         
         try:
-            msg_str = json.dumps(message, ensure_ascii=False)
+            # 按换行分帧
+            msg_str = json.dumps(message, ensure_ascii=False) + '\n'
             self.writer.write(msg_str.encode('utf-8'))
             await self.writer.drain()
             self.result.messages_sent += 1
@@ -66,18 +66,23 @@ private:
     }
 
     void onMessage(const TcpConnectionPtr& conn, Buffer* buf, Timestamp time) {
-        std::string message = buf->retrieveAllAsString();
-        try {
-            json response = json::parse(message);
-            messageCount_++;
-            
-            // 可以在这里处理服务器响应
-            if (response.contains("msgid")) {
-                int msgId = response["msgid"];
-                // LOG_INFO << "Client " << clientId_ << " received response for msgId: " << msgId;
+        // 响应以换行符分隔，一次可能收到多条或半条
+        const char* eol;
+        while ((eol = buf->findEOL()) != nullptr) {
+            std::string message(buf->peek(), eol);
+            buf->retrieveUntil(eol + 1);
+            try {
+                json response = json::parse(message);
+                messageCount_++;
+                
+                // 可以在这里处理服务器响应
+                if (response.contains("msgid")) {
+                    int msgId = response["msgid"];
+                    // LOG_INFO << "Client " << clientId_ << " received response for msgId: " << msgId;
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR << "Failed to parse response: " << e.what();
             }
-        } catch (const std::exception& e) {
-            LOG_ERROR << "Failed to parse response: " << e.what();
         }
     }
 